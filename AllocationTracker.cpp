@@ -0,0 +1,329 @@
+//
+// Replacement global operator new/delete (plain, nothrow and over-aligned) that keep the counters behind
+// AllocationScope, and in MEMORY_POLICY builds the mmap interposers behind mappedBytes. See AllocationTracker.h.
+//
+
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Only MEMORY_POLICY builds interpose mmap, the other test executables leave the system calls alone
+#if defined(DS2_TEST_MEMORY_POLICY) && defined(__linux__) && defined(__LP64__)
+#define TRACK_MAPPINGS
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	std::atomic<size_t> liveBytes(0);
+	std::atomic<size_t> peakBytes(0);
+	std::atomic<size_t> allocations(0);
+	std::atomic<size_t> deallocations(0);
+	std::atomic<long long> mappedBytes(0);
+	
+	// Every block is prefixed with its size; the header keeps the returned pointer max-aligned
+	const size_t HEADER_SIZE = alignof(std::max_align_t);
+	
+	void countAlloc(size_t size)
+	{
+		size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		size_t peak = peakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		{}
+		allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	
+	void countFree(size_t size)
+	{
+		liveBytes.fetch_sub(size, std::memory_order_relaxed);
+		deallocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	
+	void* trackedAlloc(size_t size)
+	{
+		void* raw = std::malloc(size + HEADER_SIZE);
+		if (!raw)
+		{
+			return nullptr;
+		}
+		*static_cast<size_t*>(raw) = size;
+		countAlloc(size);
+		return static_cast<char*>(raw) + HEADER_SIZE;
+	}
+	
+	void* trackedNew(size_t size)
+	{
+		void* p = trackedAlloc(size ? size : 1);
+		if (!p)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+	
+	void trackedFree(void* p)
+	{
+		if (!p)
+		{
+			return;
+		}
+		void* raw = static_cast<char*>(p) - HEADER_SIZE;
+		countFree(*static_cast<size_t*>(raw));
+		std::free(raw);
+	}
+	
+#ifdef __cpp_aligned_new
+	// Over-aligned blocks: the size and the pointer malloc returned are kept in the two words before the block
+	void* trackedAlignedAlloc(size_t size, std::align_val_t alignment)
+	{
+		size_t align = static_cast<size_t>(alignment);
+		size_t header = 2 * sizeof(void*);
+		void* raw = std::malloc(size + header + align);
+		if (!raw)
+		{
+			return nullptr;
+		}
+		uintptr_t start = reinterpret_cast<uintptr_t>(raw) + header;
+		void** p = reinterpret_cast<void**>((start + align - 1) / align * align);
+		p[-1] = reinterpret_cast<void*>(size);
+		p[-2] = raw;
+		countAlloc(size);
+		return p;
+	}
+	
+	void* trackedAlignedNew(size_t size, std::align_val_t alignment)
+	{
+		void* p = trackedAlignedAlloc(size ? size : 1, alignment);
+		if (!p)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+	
+	void trackedAlignedFree(void* p)
+	{
+		if (!p)
+		{
+			return;
+		}
+		void** header = static_cast<void**>(p);
+		countFree(reinterpret_cast<size_t>(header[-1]));
+		std::free(header[-2]);
+	}
+#endif
+}
+
+AllocationStats allocationStats()
+{
+	return {liveBytes.load(), peakBytes.load(), allocations.load(), deallocations.load(), mappedBytes.load()};
+}
+
+void resetPeakBytes()
+{
+	peakBytes.store(liveBytes.load());
+}
+
+AllocationScope::AllocationScope()
+{
+	resetPeakBytes();
+	start = allocationStats();
+}
+
+long long AllocationScope::liveBytes() const
+{
+	return static_cast<long long>(allocationStats().liveBytes) - static_cast<long long>(start.liveBytes);
+}
+
+size_t AllocationScope::peakBytes() const
+{
+	return allocationStats().peakBytes - start.liveBytes;
+}
+
+size_t AllocationScope::allocations() const
+{
+	return allocationStats().allocations - start.allocations;
+}
+
+size_t AllocationScope::deallocations() const
+{
+	return allocationStats().deallocations - start.deallocations;
+}
+
+long long AllocationScope::mappedBytes() const
+{
+	return allocationStats().mappedBytes - start.mappedBytes;
+}
+
+void* operator new(size_t size)
+{
+	return trackedNew(size);
+}
+
+void* operator new[](size_t size)
+{
+	return trackedNew(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return trackedAlloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return trackedAlloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept
+{
+	trackedFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	trackedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	trackedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	trackedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	trackedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	trackedFree(p);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return trackedAlignedNew(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return trackedAlignedNew(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return trackedAlignedAlloc(size ? size : 1, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return trackedAlignedAlloc(size ? size : 1, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	trackedAlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+	trackedAlignedFree(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+	trackedAlignedFree(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+	trackedAlignedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	trackedAlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	trackedAlignedFree(p);
+}
+#endif
+
+#ifdef TRACK_MAPPINGS
+// The wrappers go straight to the system calls. glibc's own mappings (malloc arenas, thread stacks) use its
+// internal entry points and are not counted.
+namespace
+{
+	long long pageAligned(size_t length)
+	{
+		static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		return static_cast<long long>((length + pageSize - 1) / pageSize * pageSize);
+	}
+}
+
+namespace
+{
+	void* trackedMmap(void* addr, size_t length, int prot, int flags, int fd, long long offset)
+	{
+		void* p = reinterpret_cast<void*>(syscall(SYS_mmap, addr, length, prot, flags, fd, offset));
+		if (p != MAP_FAILED)
+		{
+			mappedBytes.fetch_add(pageAligned(length), std::memory_order_relaxed);
+		}
+		return p;
+	}
+}
+
+extern "C" void* mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset)
+{
+	return trackedMmap(addr, length, prot, flags, fd, offset);
+}
+
+// A separate symbol in glibc, used by code built with large file support
+extern "C" void* mmap64(void* addr, size_t length, int prot, int flags, int fd, off64_t offset)
+{
+	return trackedMmap(addr, length, prot, flags, fd, offset);
+}
+
+extern "C" void* mremap(void* oldAddress, size_t oldSize, size_t newSize, int flags, ...)
+{
+	void* newAddress = nullptr;
+	if (flags & MREMAP_FIXED)
+	{
+		va_list args;
+		va_start(args, flags);
+		newAddress = va_arg(args, void*);
+		va_end(args);
+	}
+	void* p = reinterpret_cast<void*>(syscall(SYS_mremap, oldAddress, oldSize, newSize, flags, newAddress));
+	if (p != MAP_FAILED)
+	{
+		mappedBytes.fetch_add(pageAligned(newSize) - pageAligned(oldSize), std::memory_order_relaxed);
+	}
+	return p;
+}
+
+extern "C" int munmap(void* addr, size_t length)
+{
+	int res = static_cast<int>(syscall(SYS_munmap, addr, length));
+	if (res == 0)
+	{
+		mappedBytes.fetch_sub(pageAligned(length), std::memory_order_relaxed);
+	}
+	return res;
+}
+#endif
@@ -0,0 +1,56 @@
+//
+// Global operator new/delete interposer for the test executables.
+// Every allocation made through new/delete is counted, so tests can assert on leaks and allocation counts. This
+// includes the over-aligned (std::align_val_t) forms, e.g. a cache-line aligned node pool.
+// When MEMORY_POLICY is in DS2_FEATURES, on 64-bit Linux, mmap/mmap64/mremap/munmap calls made by the tested code
+// are counted too (mappedBytes), so memory a structure maps for itself, e.g. under a huge page policy, is not
+// invisible to the leak tests. Other builds do not interpose them and mappedBytes stays 0.
+//
+
+#ifndef DATASTRUCTURES2_ALLOCATIONTRACKER_H
+#define DATASTRUCTURES2_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+struct AllocationStats
+{
+	size_t liveBytes;
+	size_t peakBytes;
+	size_t allocations;
+	size_t deallocations;
+	long long mappedBytes;
+};
+
+// Counters since program start
+AllocationStats allocationStats();
+
+// Restarts peak tracking from the current number of live bytes
+void resetPeakBytes();
+
+// Measures the allocations made during its lifetime (opening a scope restarts peak tracking), e.g.
+//     AllocationScope scope;
+//     { AVL_Tree<int, int> tree; ... }
+//     EXPECT_EQ(scope.liveBytes(), 0);
+class AllocationScope
+{
+public:
+	AllocationScope();
+	
+	// Bytes allocated and not yet freed since the scope was opened (negative if memory from before was freed)
+	long long liveBytes() const;
+	
+	// Highest liveBytes() seen since the scope was opened
+	size_t peakBytes() const;
+	
+	size_t allocations() const;
+	
+	size_t deallocations() const;
+	
+	// Bytes mapped with mmap/mremap and not yet unmapped since the scope was opened, in whole pages (MEMORY_POLICY)
+	long long mappedBytes() const;
+
+private:
+	AllocationStats start;
+};
+
+#endif //DATASTRUCTURES2_ALLOCATIONTRACKER_H
@@ -0,0 +1,205 @@
+//
+// Runs the same olympics_t-like operation mix through every combination of hash table and ordered tree backends
+// and prints a comparison table (ops/sec, p50/p99 latency, peak RSS).
+//
+// Usage: Backends_bench [numOps] [idRange]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../HashTable.h"
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+#include "StdAdapters.h"
+#include "../Blackbox_Testing/OlympicsTestUtils.h"
+
+struct Op
+{
+	OpType type;
+	int first;
+	int second;
+};
+
+// A team reduced to its strength, so that only container costs are measured
+struct TeamEntry
+{
+	int id;
+	int strength;
+};
+
+// The three team containers of olympics_t, with the backends as template parameters.
+// As in olympics_t, all three hold a pointer to the same team object, so a strength change only re-keys
+// teamsByStrength.
+template <template <class, class> class Table, template <class, class> class Tree>
+class TeamIndex
+{
+public:
+	~TeamIndex()
+	{
+		while (teamsById.get_size() > 0)
+		{
+			remove_team(teamsById.get_min().ans()->id);
+		}
+	}
+
+	StatusType add_team(int teamId)
+	{
+		if (teamsHashTable.find(teamId).status() == SUCCESS)
+		{
+			return FAILURE;
+		}
+		TeamEntry* team = new TeamEntry{teamId, 0};
+		teamsHashTable.insert(teamId, team);
+		teamsById.insert(teamId, team);
+		teamsByStrength.insert(strengthKey(teamId, 0), team);
+		return SUCCESS;
+	}
+
+	StatusType remove_team(int teamId)
+	{
+		auto res = teamsHashTable.find(teamId);
+		if (res.status() != SUCCESS)
+		{
+			return FAILURE;
+		}
+		TeamEntry* team = res.ans();
+		teamsByStrength.remove(strengthKey(teamId, team->strength));
+		teamsById.remove(teamId);
+		teamsHashTable.remove(teamId);
+		delete team;
+		return SUCCESS;
+	}
+
+	StatusType change_strength(int teamId, int delta)
+	{
+		auto res = teamsHashTable.find(teamId);
+		if (res.status() != SUCCESS)
+		{
+			return FAILURE;
+		}
+		TeamEntry* team = res.ans();
+		teamsByStrength.remove(strengthKey(teamId, team->strength));
+		team->strength = std::max(0, team->strength + delta);
+		return teamsByStrength.insert(strengthKey(teamId, team->strength), team);
+	}
+
+	output_t<int> play_match(int teamId1, int teamId2)
+	{
+		auto res1 = teamsHashTable.find(teamId1);
+		auto res2 = teamsHashTable.find(teamId2);
+		if (res1.status() != SUCCESS || res2.status() != SUCCESS)
+		{
+			return FAILURE;
+		}
+		return res1.ans()->strength >= res2.ans()->strength ? teamId1 : teamId2;
+	}
+
+private:
+	static long long strengthKey(int teamId, int strength)
+	{
+		return (static_cast<long long>(strength) << 32) | static_cast<unsigned int>(teamId);
+	}
+
+	Table<int, TeamEntry*> teamsHashTable;
+	Tree<int, TeamEntry*> teamsById;
+	Tree<long long, TeamEntry*> teamsByStrength;
+};
+
+// Operation mix: 10% add team, 5% remove team, 40% add player, 15% remove player, 30% play match
+std::vector<Op> generateOps(int numOps, int idRange)
+{
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, idRange);
+	std::uniform_int_distribution<int> strength(1, 100);
+	std::uniform_int_distribution<int> kind(0, 99);
+	std::vector<Op> ops;
+	ops.reserve(numOps);
+	for (int i = 0; i < numOps; ++i)
+	{
+		int k = kind(gen);
+		if (k < 10)
+		{
+			ops.push_back({ADD_TEAM, id(gen), 0});
+		}
+		else if (k < 15)
+		{
+			ops.push_back({REMOVE_TEAM, id(gen), 0});
+		}
+		else if (k < 55)
+		{
+			ops.push_back({ADD_PLAYER, id(gen), strength(gen)});
+		}
+		else if (k < 70)
+		{
+			ops.push_back({REMOVE_PLAYER, id(gen), strength(gen)});
+		}
+		else
+		{
+			ops.push_back({PLAY_GAME, id(gen), id(gen)});
+		}
+	}
+	return ops;
+}
+
+template <template <class, class> class Table, template <class, class> class Tree>
+void runCombination(const char* tableName, const char* treeName, const std::vector<Op>& ops, int idRange)
+{
+	runIsolated([&]
+				{
+					TeamIndex<Table, Tree> index;
+					// Start from a populated index so lookups are not dominated by misses
+					for (int id = 1; id <= idRange; id += 2)
+					{
+						index.add_team(id);
+					}
+
+					LatencySamples samples;
+					samples.reserve(ops.size());
+					long long checksum = 0;
+					for (const Op& op : ops)
+					{
+						auto start = BenchClock::now();
+						switch (op.type)
+						{
+							case ADD_TEAM:
+								checksum += static_cast<int>(index.add_team(op.first));
+								break;
+							case REMOVE_TEAM:
+								checksum += static_cast<int>(index.remove_team(op.first));
+								break;
+							case ADD_PLAYER:
+								checksum += static_cast<int>(index.change_strength(op.first, op.second));
+								break;
+							case REMOVE_PLAYER:
+								checksum += static_cast<int>(index.change_strength(op.first, -op.second));
+								break;
+							default:
+								checksum += index.play_match(op.first, op.second).ans();
+								break;
+						}
+						samples.add(elapsedNs(start, BenchClock::now()));
+					}
+					std::printf("%-14s %-16s %14.0f %10lld %10lld %14ld  (checksum %lld)\n", tableName, treeName,
+								samples.opsPerSec(), samples.percentile(0.5), samples.percentile(0.99), peakRssKb(),
+								checksum);
+				});
+}
+
+int main(int argc, char** argv)
+{
+	int numOps = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int idRange = argc > 2 ? std::atoi(argv[2]) : 100000;
+	std::vector<Op> ops = generateOps(numOps, idRange);
+
+	std::printf("%d operations over team ids 1..%d\n", numOps, idRange);
+	std::printf("%-14s %-16s %14s %10s %10s %14s\n", "Table", "Tree", "ops/sec", "p50 (ns)", "p99 (ns)",
+				"peak RSS (KB)");
+	runCombination<HashTable, AVL_Tree>("HashTable", "AVL_Tree", ops, idRange);
+	runCombination<HashTable, StdOrderedTree>("HashTable", "std::map", ops, idRange);
+	runCombination<StdHashTable, AVL_Tree>("unordered_map", "AVL_Tree", ops, idRange);
+	runCombination<StdHashTable, StdOrderedTree>("unordered_map", "std::map", ops, idRange);
+	return 0;
+}
@@ -0,0 +1,214 @@
+//
+// Shared helpers for the benchmark executables: a steady clock, per-operation latency percentiles, peak RSS,
+// hardware event counters (perf_event_open on Linux), and runIsolated to give every run its own process.
+//
+
+#ifndef DATASTRUCTURES2_BENCHMARKUTILS_H
+#define DATASTRUCTURES2_BENCHMARKUTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_HAS_FORK 1
+#endif
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+typedef std::chrono::steady_clock BenchClock;
+
+inline long long elapsedNs(BenchClock::time_point start, BenchClock::time_point end)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// Per-operation latency samples of a single benchmark run, in nanoseconds
+class LatencySamples
+{
+public:
+	void reserve(size_t n)
+	{
+		samples.reserve(n);
+	}
+	
+	void add(long long ns)
+	{
+		samples.push_back(ns);
+		total += ns;
+		sorted = false;
+	}
+	
+	size_t count() const
+	{
+		return samples.size();
+	}
+	
+	double opsPerSec() const
+	{
+		return total ? samples.size() * 1e9 / total : 0;
+	}
+	
+	// p in [0, 1], e.g. 0.99 for p99
+	long long percentile(double p)
+	{
+		if (samples.empty())
+		{
+			return 0;
+		}
+		if (!sorted)
+		{
+			std::sort(samples.begin(), samples.end());
+			sorted = true;
+		}
+		size_t index = static_cast<size_t>(p * (samples.size() - 1));
+		return samples[index];
+	}
+
+private:
+	std::vector<long long> samples;
+	long long total = 0;
+	bool sorted = true;
+};
+
+// Peak resident set size of the current process in KB, or -1 where it cannot be queried
+inline long peakRssKb()
+{
+#ifdef BENCH_HAS_FORK
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return -1;
+#endif
+}
+
+// Hardware event counter for the calling thread, through perf_event_open where available.
+// available() is false when the kernel, permissions (perf_event_paranoid) or platform do not allow it.
+class PerfCounter
+{
+public:
+	// type/config as in perf_event_attr, e.g. PERF_TYPE_HW_CACHE and a dTLB read miss config
+	PerfCounter(unsigned int type, unsigned long long config) : fd(-1)
+	{
+#ifdef __linux__
+		struct perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+		(void) type;
+		(void) config;
+#endif
+	}
+	
+	~PerfCounter()
+	{
+#ifdef __linux__
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+#endif
+	}
+	
+	PerfCounter(const PerfCounter&) = delete;
+	PerfCounter& operator=(const PerfCounter&) = delete;
+	
+	bool available() const
+	{
+		return fd >= 0;
+	}
+	
+	void start()
+	{
+#ifdef __linux__
+		if (fd >= 0)
+		{
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+	
+	// Events counted since start(), or -1 if the counter is not available
+	long long stop()
+	{
+#ifdef __linux__
+		long long count;
+		if (fd >= 0 && ioctl(fd, PERF_EVENT_IOC_DISABLE, 0) == 0 && read(fd, &count, sizeof(count)) == sizeof(count))
+		{
+			return count;
+		}
+#endif
+		return -1;
+	}
+
+private:
+	int fd;
+};
+
+#ifdef __linux__
+// dTLB read misses, for PerfCounter
+#define DTLB_READ_MISS_EVENT PERF_TYPE_HW_CACHE, \
+	(PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+#else
+#define DTLB_READ_MISS_EVENT 0, 0
+#endif
+
+// Runs f in a child process where fork() is available, so every benchmark run reports its own peak RSS
+// and a run that leaks or crashes does not affect the ones after it. A run that crashes or exits with an error
+// is reported on stderr.
+template <class F>
+void runIsolated(F f)
+{
+#ifdef BENCH_HAS_FORK
+	std::fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		f();
+		std::fflush(stdout);
+		_exit(0);
+	}
+	if (pid > 0)
+	{
+		int status;
+		if (waitpid(pid, &status, 0) < 0)
+		{
+			std::perror("waitpid");
+		}
+		else if (WIFSIGNALED(status))
+		{
+			std::fprintf(stderr, "Benchmark run killed by signal %d\n", WTERMSIG(status));
+		}
+		else if (WIFEXITED(status) && WEXITSTATUS(status) != 0)
+		{
+			std::fprintf(stderr, "Benchmark run exited with status %d\n", WEXITSTATUS(status));
+		}
+		return;
+	}
+#endif
+	f();
+}
+
+#endif //DATASTRUCTURES2_BENCHMARKUTILS_H
@@ -0,0 +1,84 @@
+//
+// AVL_Tree::bulk_build from unsorted arrays on 1..32 threads, compared to a serial std::sort followed by the
+// sorted-array constructor. Runs with int keys (teamsById, radix sort) and with Pair keys (teamsByStrength,
+// merge sort). Speedup and efficiency (speedup per thread) are relative to the serial baseline.
+//
+// Usage: BulkBuild_bench [size] [maxThreads]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+// Serial baseline: sort an index by key, gather, and build through the sorted-array constructor
+template <class K>
+double serialBuildMs(const std::vector<K>& keys, const std::vector<int>& values)
+{
+	auto start = BenchClock::now();
+	std::vector<int> order(keys.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](int a, int b)
+	{
+		return keys[a] < keys[b];
+	});
+	std::vector<K> sortedKeys;
+	std::vector<int> sortedValues;
+	sortedKeys.reserve(keys.size());
+	sortedValues.reserve(keys.size());
+	for (int i : order)
+	{
+		sortedKeys.push_back(keys[i]);
+		sortedValues.push_back(values[i]);
+	}
+	AVL_Tree<K, int> tree = AVL_Tree<K, int>(sortedValues.data(), sortedKeys.data(), keys.size());
+	return elapsedNs(start, BenchClock::now()) / 1e6;
+}
+
+template <class K>
+void run(const char* label, const std::vector<K>& keys, const std::vector<int>& values, int maxThreads)
+{
+	double serialMs = serialBuildMs(keys, values);
+	std::printf("%-6s %-22s %12.1f %10s %12s\n", label, "sort + constructor", serialMs, "1.00x", "-");
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		runIsolated([&]
+					{
+						AVL_Tree<K, int> tree = AVL_Tree<K, int>();
+						auto start = BenchClock::now();
+						StatusType res = tree.bulk_build(values.data(), keys.data(), keys.size(), threads);
+						double ms = elapsedNs(start, BenchClock::now()) / 1e6;
+						std::printf("%-6s bulk_build, %2d threads %12.1f %9.2fx %11.0f%%%s\n", label, threads, ms,
+									serialMs / ms, 100 * serialMs / ms / threads,
+									res == StatusType::SUCCESS ? "" : "  (failed)");
+					});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+	int maxThreads = argc > 2 ? std::atoi(argv[2]) : 32;
+	
+	// Distinct ids in a random order, and {teamId, strength} keys as in teamsByStrength, with many tied strengths
+	std::vector<int> ids(n);
+	std::iota(ids.begin(), ids.end(), 1);
+	std::shuffle(ids.begin(), ids.end(), std::mt19937(2024));
+	std::vector<Pair<int, int>> strengthKeys;
+	strengthKeys.reserve(n);
+	for (int id : ids)
+	{
+		strengthKeys.emplace_back(id, id % 1000);
+	}
+	
+	std::printf("%d records, %u hardware threads\n", n, std::thread::hardware_concurrency());
+	std::printf("%-6s %-22s %12s %10s %12s\n", "keys", "method", "time (ms)", "speedup", "efficiency");
+	run("int", ids, ids, maxThreads);
+	run("Pair", strengthKeys, ids, maxThreads);
+	return 0;
+}
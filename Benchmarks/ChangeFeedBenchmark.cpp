@@ -0,0 +1,134 @@
+//
+// Producer overhead of the olympics_t change feed: the same operation mix with the feed disabled, enabled with a
+// consumer thread draining it in batches, and enabled with no consumer (every record dropped as overflow).
+//
+// Usage: ChangeFeed_bench [numOps] [numTeams] [capacity]
+//
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../../olympics24a2.h"
+#include "BenchmarkUtils.h"
+
+enum FeedMode
+{
+	DISABLED, DRAINED, OVERFLOWING
+};
+
+struct Op
+{
+	int kind;
+	int first;
+	int second;
+};
+
+// Operation mix: 40% add player, 30% remove player, 25% play match, 5% remove and re-add a team
+std::vector<Op> generateOps(int numOps, int numTeams)
+{
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, numTeams);
+	std::uniform_int_distribution<int> strength(1, 1000);
+	std::uniform_int_distribution<int> kind(0, 99);
+	std::vector<Op> ops;
+	ops.reserve(numOps);
+	for (int i = 0; i < numOps; ++i)
+	{
+		int k = kind(gen);
+		ops.push_back({k < 40 ? 0 : k < 70 ? 1 : k < 95 ? 2 : 3, id(gen), k < 40 ? strength(gen) : id(gen)});
+	}
+	return ops;
+}
+
+void run(const char* label, FeedMode mode, const std::vector<Op>& ops, int numTeams, int capacity,
+		 double& disabledNs)
+{
+	olympics_t olympics;
+	for (int teamId = 1; teamId <= numTeams; ++teamId)
+	{
+		olympics.add_team(teamId);
+		olympics.add_player(teamId, teamId % 1000 + 1);
+	}
+	if (mode != DISABLED)
+	{
+		olympics.enable_change_feed(capacity);
+	}
+	
+	std::atomic<bool> done(false);
+	long long drained = 0;
+	std::thread consumer;
+	if (mode == DRAINED)
+	{
+		consumer = std::thread([&]
+							   {
+								   std::vector<ChangeRecord> batch(256);
+								   while (true)
+								   {
+									   bool finished = done.load();
+									   int n = olympics.drain_changes(batch.data(), batch.size());
+									   drained += n;
+									   if (finished && n == 0)
+									   {
+										   return;
+									   }
+									   if (n == 0)
+									   {
+										   std::this_thread::yield();
+									   }
+								   }
+							   });
+	}
+	
+	long long checksum = 0;
+	auto start = BenchClock::now();
+	for (const Op& op : ops)
+	{
+		switch (op.kind)
+		{
+			case 0:
+				checksum += static_cast<int>(olympics.add_player(op.first, op.second));
+				break;
+			case 1:
+				checksum += static_cast<int>(olympics.remove_newest_player(op.first));
+				break;
+			case 2:
+				checksum += olympics.play_match(op.first, op.second).ans();
+				break;
+			default:
+				checksum += static_cast<int>(olympics.remove_team(op.first));
+				checksum += static_cast<int>(olympics.add_team(op.first));
+				break;
+		}
+	}
+	double ns = elapsedNs(start, BenchClock::now()) / static_cast<double>(ops.size());
+	done.store(true);
+	if (consumer.joinable())
+	{
+		consumer.join();
+	}
+	if (mode == DISABLED)
+	{
+		disabledNs = ns;
+	}
+	std::printf("%-12s %10.1f %+11.1f %12lld %12lld  (checksum %lld)\n", label, ns, ns - disabledNs, drained,
+				olympics.get_dropped_changes(), checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int numOps = argc > 1 ? std::atoi(argv[1]) : 5000000;
+	int numTeams = argc > 2 ? std::atoi(argv[2]) : 100000;
+	int capacity = argc > 3 ? std::atoi(argv[3]) : 1 << 16;
+	std::vector<Op> ops = generateOps(numOps, numTeams);
+	
+	std::printf("%d operations over %d teams, feed capacity %d\n", numOps, numTeams, capacity);
+	std::printf("%-12s %10s %11s %12s %12s\n", "feed", "ns/op", "overhead", "drained", "dropped");
+	double disabledNs = 0;
+	run("disabled", DISABLED, ops, numTeams, capacity, disabledNs);
+	run("drained", DRAINED, ops, numTeams, capacity, disabledNs);
+	run("overflowing", OVERFLOWING, ops, numTeams, capacity, disabledNs);
+	return 0;
+}
@@ -0,0 +1,76 @@
+//
+// Tail latency of find for HashTable and CuckooHashTable, for random keys and for keys sharing their low bits.
+// Every find is timed on its own; the timer overhead is included in all columns alike.
+//
+// Usage: Cuckoo_bench [size] [numLookups]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../HashTable.h"
+#include "../../CuckooHashTable.h"
+#include "BenchmarkUtils.h"
+
+template <class Table>
+void run(const char* tableName, const char* keysName, const std::vector<int>& keys, const std::vector<int>& lookups)
+{
+	Table table;
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		table.insert(keys[i], static_cast<int>(i));
+	}
+	
+	LatencySamples samples;
+	samples.reserve(lookups.size());
+	long long checksum = 0;
+	for (int key : lookups)
+	{
+		auto start = BenchClock::now();
+		auto res = table.find(key);
+		samples.add(elapsedNs(start, BenchClock::now()));
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : -1;
+	}
+	std::printf("%-16s %-10s %10lld %10lld %10lld %12lld %10lld  (checksum %lld)\n", tableName, keysName,
+				samples.percentile(0.5), samples.percentile(0.99), samples.percentile(0.999),
+				samples.percentile(0.9999), samples.percentile(1), checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int size = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int numLookups = argc > 2 ? std::atoi(argv[2]) : 10000000;
+	
+	std::mt19937 gen(2024);
+	std::vector<int> randomKeys(size);
+	std::vector<int> lowBitKeys(size);
+	for (int i = 0; i < size; ++i)
+	{
+		randomKeys[i] = static_cast<int>(gen() >> 1);
+		lowBitKeys[i] = i << 10;
+	}
+	
+	// Half of the lookups hit, half miss
+	std::vector<int> randomLookups(numLookups);
+	std::vector<int> lowBitLookups(numLookups);
+	std::uniform_int_distribution<int> index(0, size - 1);
+	for (int i = 0; i < numLookups; ++i)
+	{
+		int j = index(gen);
+		randomLookups[i] = i % 2 ? randomKeys[j] : static_cast<int>(gen() >> 1);
+		lowBitLookups[i] = i % 2 ? lowBitKeys[j] : lowBitKeys[j] + 1;
+	}
+	
+	std::printf("%d keys, %d finds (50%% hits), latency in ns\n", size, numLookups);
+	std::printf("%-16s %-10s %10s %10s %10s %12s %10s\n", "table", "keys", "p50", "p99", "p99.9", "p99.99", "max");
+	runIsolated([&]
+				{ run<HashTable<int, int>>("HashTable", "random", randomKeys, randomLookups); });
+	runIsolated([&]
+				{ run<CuckooHashTable<int, int>>("CuckooHashTable", "random", randomKeys, randomLookups); });
+	runIsolated([&]
+				{ run<HashTable<int, int>>("HashTable", "low bits", lowBitKeys, lowBitLookups); });
+	runIsolated([&]
+				{ run<CuckooHashTable<int, int>>("CuckooHashTable", "low bits", lowBitKeys, lowBitLookups); });
+	return 0;
+}
@@ -0,0 +1,64 @@
+//
+// Throughput of AVL_Tree::export_columns / import_columns compared to writing the tree with inorder().
+// Throughput is counted in bytes of raw key and value data (n * (sizeof(K) + sizeof(V))) per second.
+//
+// Usage: Export_bench [size] [directory]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+int main(int argc, char** argv)
+{
+	int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+	std::string dir = argc > 2 ? argv[2] : ".";
+	std::string textPath = dir + "/export_bench.txt";
+	std::string columnsPath = dir + "/export_bench.cols";
+	
+	int* keys = new int[n];
+	int* values = new int[n];
+	for (int i = 0; i < n; ++i)
+	{
+		keys[i] = 3 * i;
+		values[i] = i;
+	}
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>(values, keys, n);
+	delete[] keys;
+	delete[] values;
+	double gigabytes = n * (sizeof(int) + sizeof(int)) / 1e9;
+	
+	std::printf("%d pairs (%.3f GB of raw data)\n", n, gigabytes);
+	std::printf("%-24s %12s %10s\n", "method", "time (ms)", "GB/s");
+	
+	auto start = BenchClock::now();
+	{
+		std::ofstream out(textPath);
+		tree.inorder(out);
+	}
+	double ms = elapsedNs(start, BenchClock::now()) / 1e6;
+	std::printf("%-24s %12.1f %10.3f\n", "inorder", ms, gigabytes / (ms / 1e3));
+	
+	for (bool deltaKeys : {false, true})
+	{
+		start = BenchClock::now();
+		StatusType res = tree.export_columns(columnsPath.c_str(), deltaKeys);
+		ms = elapsedNs(start, BenchClock::now()) / 1e6;
+		std::printf("%-24s %12.1f %10.3f%s\n", deltaKeys ? "export_columns (delta)" : "export_columns", ms,
+					gigabytes / (ms / 1e3), res == StatusType::SUCCESS ? "" : "  (failed)");
+		
+		AVL_Tree<int, int> imported = AVL_Tree<int, int>();
+		start = BenchClock::now();
+		res = imported.import_columns(columnsPath.c_str());
+		ms = elapsedNs(start, BenchClock::now()) / 1e6;
+		std::printf("%-24s %12.1f %10.3f%s\n", deltaKeys ? "import_columns (delta)" : "import_columns", ms,
+					gigabytes / (ms / 1e3), res == StatusType::SUCCESS && imported.get_size() == n ? "" : "  (failed)");
+	}
+	
+	std::remove(textPath.c_str());
+	std::remove(columnsPath.c_str());
+	return 0;
+}
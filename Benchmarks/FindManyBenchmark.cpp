@@ -0,0 +1,79 @@
+//
+// Batched HashTable::find_many against a loop of single find() calls on a table much larger than the LLC,
+// for several batch sizes and hit rates.
+//
+// Usage: FindMany_bench [tableSize] [numLookups]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../HashTable.h"
+#include "BenchmarkUtils.h"
+
+void run(HashTable<int, int>& table, const std::vector<int>& keys, int batchSize, const char* label)
+{
+	std::vector<output_t<int>> results(batchSize);
+	long long checksum = 0;
+	
+	auto start = BenchClock::now();
+	for (size_t i = 0; i + batchSize <= keys.size(); i += batchSize)
+	{
+		for (int j = 0; j < batchSize; ++j)
+		{
+			auto res = table.find(keys[i + j]);
+			checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+		}
+	}
+	double singleNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	
+	start = BenchClock::now();
+	for (size_t i = 0; i + batchSize <= keys.size(); i += batchSize)
+	{
+		table.find_many(keys.data() + i, batchSize, results.data());
+		for (int j = 0; j < batchSize; ++j)
+		{
+			checksum -= results[j].status() == StatusType::SUCCESS ? results[j].ans() : 0;
+		}
+	}
+	double batchNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	
+	std::printf("%-10s %8d %14.1f %14.1f %9.2fx%s\n", label, batchSize, singleNs, batchNs, singleNs / batchNs,
+				checksum ? "  (results differ)" : "");
+}
+
+int main(int argc, char** argv)
+{
+	int tableSize = argc > 1 ? std::atoi(argv[1]) : 1 << 24;
+	int numLookups = argc > 2 ? std::atoi(argv[2]) : 1 << 22;
+	
+	HashTable<int, int> table;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> key(0, 2 * tableSize);
+	for (int i = 0; i < tableSize; ++i)
+	{
+		table.insert(2 * i, i);
+	}
+	
+	// Even keys are present, odd keys are not
+	std::vector<int> hits(numLookups);
+	std::vector<int> mixed(numLookups);
+	for (int i = 0; i < numLookups; ++i)
+	{
+		hits[i] = key(gen) & ~1;
+		mixed[i] = key(gen);
+	}
+	
+	std::printf("%d keys, %d lookups, peak RSS %ld KB\n", table.get_size(), numLookups, peakRssKb());
+	std::printf("%-10s %8s %14s %14s %10s\n", "keys", "batch", "find (ns)", "find_many (ns)", "speedup");
+	for (int batchSize : {8, 16, 32, 64})
+	{
+		run(table, hits, batchSize, "hits");
+	}
+	for (int batchSize : {8, 16, 32, 64})
+	{
+		run(table, mixed, batchSize, "50% hits");
+	}
+	return 0;
+}
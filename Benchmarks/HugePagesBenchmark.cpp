@@ -0,0 +1,76 @@
+//
+// HashTable::find and AVL_Tree::find throughput and dTLB read misses with the default memory policy and with
+// set_memory_policy(true, numaNode) (huge pages, optionally bound to a NUMA node).
+// dTLB misses are read through perf_event_open and shown as n/a where it is not permitted.
+//
+// Usage: HugePages_bench [size] [numLookups] [numaNode]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../HashTable.h"
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+template <class Structure>
+void run(const char* name, bool hugePages, int numaNode, int size, const std::vector<int>& lookups)
+{
+	Structure structure;
+	StatusType policy = hugePages ? structure.set_memory_policy(true, numaNode) : StatusType::SUCCESS;
+	for (int i = 0; i < size; ++i)
+	{
+		structure.insert(i, i);
+	}
+	
+	PerfCounter dtlbMisses(DTLB_READ_MISS_EVENT);
+	long long checksum = 0;
+	dtlbMisses.start();
+	auto start = BenchClock::now();
+	for (int key : lookups)
+	{
+		checksum += structure.find(key).ans();
+	}
+	double ns = elapsedNs(start, BenchClock::now()) / static_cast<double>(lookups.size());
+	long long misses = dtlbMisses.stop();
+	
+	char missesPerLookup[32] = "n/a";
+	if (misses >= 0)
+	{
+		std::snprintf(missesPerLookup, sizeof(missesPerLookup), "%.3f", misses / static_cast<double>(lookups.size()));
+	}
+	std::printf("%-10s %-12s %14.1f %18s %14ld%s  (checksum %lld)\n", name, hugePages ? "huge pages" : "default",
+				ns, missesPerLookup, peakRssKb(), policy == StatusType::SUCCESS ? "" : "  (policy rejected)",
+				checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int size = argc > 1 ? std::atoi(argv[1]) : 1 << 25;
+	int numLookups = argc > 2 ? std::atoi(argv[2]) : 1 << 24;
+	int numaNode = argc > 3 ? std::atoi(argv[3]) : -1;
+	
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> key(0, size - 1);
+	std::vector<int> lookups(numLookups);
+	for (int& lookup : lookups)
+	{
+		lookup = key(gen);
+	}
+	
+	std::printf("%d keys, %d random lookups, NUMA node %d\n", size, numLookups, numaNode);
+	std::printf("%-10s %-12s %14s %18s %14s\n", "structure", "policy", "find (ns)", "dTLB misses/find",
+				"peak RSS (KB)");
+	for (bool hugePages : {false, true})
+	{
+		runIsolated([&]
+					{ run<HashTable<int, int>>("HashTable", hugePages, numaNode, size, lookups); });
+	}
+	for (bool hugePages : {false, true})
+	{
+		runIsolated([&]
+					{ run<AVL_Tree<int, int>>("AVL_Tree", hugePages, numaNode, size, lookups); });
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+//
+// Memory per id and throughput of CompressedIdIndex against AVL_Tree, for dense ids (1..n) and for ids spread
+// over a range ten times bigger than their number.
+// Memory is measured with the allocation tracker, so it counts exactly the bytes allocated through new.
+//
+// Usage: IdIndex_bench [numIds]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../CompressedIdIndex.h"
+#include "../../AVL_Tree.h"
+#include "../AllocationTracker.h"
+#include "BenchmarkUtils.h"
+
+template <class Index>
+void run(const char* indexName, const char* idsName, const std::vector<int>& ids, const std::vector<int>& lookups)
+{
+	AllocationScope scope;
+	Index index;
+	long long checksum = 0;
+	
+	auto start = BenchClock::now();
+	for (int id : ids)
+	{
+		index.insert(id, id);
+	}
+	double insertNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(ids.size());
+	double bytesPerId = scope.liveBytes() / static_cast<double>(ids.size());
+	
+	start = BenchClock::now();
+	for (int id : lookups)
+	{
+		auto res = index.find(id);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	double findNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(lookups.size());
+	
+	start = BenchClock::now();
+	checksum += index.to_vec().size();
+	double iterateNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(ids.size());
+	
+	start = BenchClock::now();
+	for (int id : ids)
+	{
+		index.remove(id);
+	}
+	double removeNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(ids.size());
+	
+	std::printf("%-18s %-8s %12.1f %12.1f %12.1f %14.1f %12.1f  (checksum %lld)\n", indexName, idsName, bytesPerId,
+				insertNs, findNs, iterateNs, removeNs, checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int numIds = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	
+	std::mt19937 gen(2024);
+	std::vector<int> dense(numIds);
+	std::vector<int> spread(numIds);
+	for (int i = 0; i < numIds; ++i)
+	{
+		dense[i] = i + 1;
+		spread[i] = 10 * i + static_cast<int>(gen() % 10);
+	}
+	std::shuffle(dense.begin(), dense.end(), gen);
+	std::shuffle(spread.begin(), spread.end(), gen);
+	std::vector<int> denseLookups(dense.begin(), dense.end());
+	std::vector<int> spreadLookups(spread.begin(), spread.end());
+	std::shuffle(denseLookups.begin(), denseLookups.end(), gen);
+	std::shuffle(spreadLookups.begin(), spreadLookups.end(), gen);
+	
+	std::printf("%d ids, times in ns per id\n", numIds);
+	std::printf("%-18s %-8s %12s %12s %12s %14s %12s\n", "index", "ids", "bytes/id", "insert", "find", "ordered scan",
+				"remove");
+	run<CompressedIdIndex<int>>("CompressedIdIndex", "dense", dense, denseLookups);
+	run<AVL_Tree<int, int>>("AVL_Tree", "dense", dense, denseLookups);
+	run<CompressedIdIndex<int>>("CompressedIdIndex", "spread", spread, spreadLookups);
+	run<AVL_Tree<int, int>>("AVL_Tree", "spread", spread, spreadLookups);
+	return 0;
+}
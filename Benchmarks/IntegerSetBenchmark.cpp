@@ -0,0 +1,161 @@
+//
+// Predecessor / successor throughput of IntegerOrderedSet against a comparison-based tree, and find / insert /
+// remove against AVL_Tree, for several universe sizes.
+// AVL_Tree has no successor query, so std::set (a red-black tree, also O(log n) comparisons) stands in for it in
+// the predecessor / successor columns.
+//
+// Usage: IntegerSet_bench [numKeys] [numQueries]
+//
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+#include "../../IntegerOrderedSet.h"
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+struct Timings
+{
+	double insertNs;
+	double findNs;
+	double predNs;
+	double succNs;
+	double removeNs;
+};
+
+Timings runSet(int maxKey, const std::vector<int>& keys, const std::vector<int>& queries, long long& checksum)
+{
+	Timings t;
+	IntegerOrderedSet<int> set = IntegerOrderedSet<int>(maxKey);
+	auto start = BenchClock::now();
+	for (int key : keys)
+	{
+		set.insert(key, key);
+	}
+	t.insertNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto res = set.find(key);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	t.findNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto res = set.predecessor(key);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	t.predNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto res = set.successor(key);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	t.succNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : keys)
+	{
+		set.remove(key);
+	}
+	t.removeNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	return t;
+}
+
+Timings runTrees(const std::vector<int>& keys, const std::vector<int>& queries, long long& checksum)
+{
+	Timings t;
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	std::set<int> ordered(keys.begin(), keys.end());
+	auto start = BenchClock::now();
+	for (int key : keys)
+	{
+		tree.insert(key, key);
+	}
+	t.insertNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto res = tree.find(key);
+		checksum -= res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	t.findNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto it = ordered.lower_bound(key);
+		checksum -= it != ordered.begin() ? *std::prev(it) : 0;
+	}
+	t.predNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : queries)
+	{
+		auto it = ordered.upper_bound(key);
+		checksum -= it != ordered.end() ? *it : 0;
+	}
+	t.succNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(queries.size());
+	
+	start = BenchClock::now();
+	for (int key : keys)
+	{
+		tree.remove(key);
+	}
+	t.removeNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+	return t;
+}
+
+void print(const char* name, int maxKey, const Timings& t)
+{
+	std::printf("%-20s %12d %10.1f %10.1f %12.1f %10.1f %10.1f\n", name, maxKey, t.insertNs, t.findNs, t.predNs,
+				t.succNs, t.removeNs);
+}
+
+int main(int argc, char** argv)
+{
+	int numKeys = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int numQueries = argc > 2 ? std::atoi(argv[2]) : 4000000;
+	
+	std::printf("%d keys, %d queries, times in ns per operation\n", numKeys, numQueries);
+	std::printf("%-20s %12s %10s %10s %12s %10s %10s\n", "structure", "max key", "insert", "find", "predecessor",
+				"successor", "remove");
+	for (long long universe : {4LL * numKeys, 1LL << 24, static_cast<long long>(INT_MAX)})
+	{
+		int maxKey = static_cast<int>(std::min<long long>(std::max<long long>(universe, numKeys), INT_MAX));
+		std::mt19937 gen(2024);
+		std::uniform_int_distribution<int> key(0, maxKey);
+		std::set<int> distinct;
+		while (static_cast<int>(distinct.size()) < numKeys)
+		{
+			distinct.insert(key(gen));
+		}
+		std::vector<int> keys(distinct.begin(), distinct.end());
+		std::shuffle(keys.begin(), keys.end(), gen);
+		std::vector<int> queries(numQueries);
+		for (int& query : queries)
+		{
+			query = key(gen);
+		}
+		
+		long long checksum = 0;
+		print("IntegerOrderedSet", maxKey, runSet(maxKey, keys, queries, checksum));
+		print("AVL_Tree / std::set", maxKey, runTrees(keys, queries, checksum));
+		if (checksum != 0)
+		{
+			std::printf("results differ (checksum %lld)\n", checksum);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,92 @@
+//
+// Miss-heavy lookup workload (finds and removes of ids that mostly do not exist, as in RemoveNonExistentTeam and
+// AddPlayerToNonExistentTeam) on a HashTable with and without a miss filter, for several false positive rates.
+//
+// Usage: MissFilter_bench [tableSize] [numLookups]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../HashTable.h"
+#include "BenchmarkUtils.h"
+
+// Keys present in the table are even, so a key is a miss exactly when it is odd
+std::vector<int> makeLookups(int tableSize, int numLookups, double missRate)
+{
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> index(0, tableSize - 1);
+	std::bernoulli_distribution miss(missRate);
+	std::vector<int> keys(numLookups);
+	for (int i = 0; i < numLookups; ++i)
+	{
+		keys[i] = 2 * index(gen) + (miss(gen) ? 1 : 0);
+	}
+	return keys;
+}
+
+// Average nanoseconds per find, with find and remove of missing keys interleaved 3:1
+double run(HashTable<int, int>& table, const std::vector<int>& keys, long long& checksum)
+{
+	auto start = BenchClock::now();
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (i % 4 == 3 && (keys[i] & 1))
+		{
+			checksum += static_cast<int>(table.remove(keys[i]));
+			continue;
+		}
+		auto res = table.find(keys[i]);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	return elapsedNs(start, BenchClock::now()) / static_cast<double>(keys.size());
+}
+
+void fill(HashTable<int, int>& table, int tableSize)
+{
+	for (int i = 0; i < tableSize; ++i)
+	{
+		table.insert(2 * i, i);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int tableSize = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+	int numLookups = argc > 2 ? std::atoi(argv[2]) : 1 << 22;
+	const double missRates[] = {0.5, 0.9, 0.99};
+	
+	std::printf("%d keys, %d lookups\n", tableSize, numLookups);
+	std::printf("%-10s %10s %12s %14s %14s %10s\n", "filter", "miss rate", "ns/op", "rejected", "filter (KB)",
+				"peak RSS (KB)");
+	
+	for (double missRate : missRates)
+	{
+		std::vector<int> keys = makeLookups(tableSize, numLookups, missRate);
+		runIsolated([&]
+					{
+						HashTable<int, int> table;
+						fill(table, tableSize);
+						long long checksum = 0;
+						double ns = run(table, keys, checksum);
+						std::printf("%-10s %9.0f%% %12.1f %14s %14s %10ld  (checksum %lld)\n", "none", missRate * 100, ns,
+									"-", "-", peakRssKb(), checksum);
+					});
+		for (double rate : {0.1, 0.01, 0.001})
+		{
+			runIsolated([&]
+						{
+							HashTable<int, int> table;
+							table.set_miss_filter(rate);
+							fill(table, tableSize);
+							long long checksum = 0;
+							double ns = run(table, keys, checksum);
+							std::printf("p=%-8g %9.0f%% %12.1f %14lld %14lld %10ld  (checksum %lld)\n", rate,
+										missRate * 100, ns, table.get_filter_rejections(),
+										table.get_filter_bytes() / 1024, peakRssKb(), checksum);
+						});
+		}
+	}
+	return 0;
+}
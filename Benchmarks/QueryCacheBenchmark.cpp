@@ -0,0 +1,114 @@
+//
+// Read-heavy olympics_t workload with and without the query cache: 90% play_tournament over a small set of
+// popular ranges, 5% play_match, 5% add_player immediately undone by remove_newest_player.
+// Each popular range holds exactly a power of two of teams, so every tournament succeeds and a cache hit has to
+// add the tournament's wins, as the tests require. The add/remove pair invalidates the cached ranges of the team
+// without changing how many teams each range holds.
+//
+// Usage: QueryCache_bench [numTeams] [numOps] [cacheCapacity]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../../olympics24a2.h"
+#include "BenchmarkUtils.h"
+
+// Number of popular tournament ranges, and the strengths each one covers
+#define NUM_RANGES 32
+#define RANGE_WIDTH 1000
+
+void run(int numTeams, int numOps, int cacheCapacity)
+{
+	olympics_t olympics;
+	if (cacheCapacity > 0)
+	{
+		olympics.enable_query_cache(cacheCapacity);
+	}
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, numTeams);
+	std::uniform_int_distribution<int> strength(1, RANGE_WIDTH * NUM_RANGES);
+	std::uniform_int_distribution<int> popularRange(0, NUM_RANGES - 1);
+	std::uniform_int_distribution<int> kind(0, 99);
+	// Range r covers strengths [r * RANGE_WIDTH + 1, (r + 1) * RANGE_WIDTH] and gets teamsPerRange teams, a power
+	// of two. A team has one player, so its strength is that player's. The remaining teams are stronger than
+	// every range.
+	int teamsPerRange = 1;
+	while (teamsPerRange * 2 * NUM_RANGES <= numTeams)
+	{
+		teamsPerRange *= 2;
+	}
+	for (int teamId = 1; teamId <= numTeams; ++teamId)
+	{
+		int index = teamId - 1;
+		int range = index / teamsPerRange;
+		int teamStrength = range < NUM_RANGES ? range * RANGE_WIDTH + 1 + index % RANGE_WIDTH
+											  : NUM_RANGES * RANGE_WIDTH + 1 + index;
+		olympics.add_team(teamId);
+		olympics.add_player(teamId, teamStrength);
+	}
+	
+	LatencySamples samples;
+	samples.reserve(numOps);
+	long long checksum = 0;
+	int tournaments = 0;
+	int succeeded = 0;
+	for (int i = 0; i < numOps; ++i)
+	{
+		int k = kind(gen);
+		auto start = BenchClock::now();
+		if (k < 90)
+		{
+			int lowPower = popularRange(gen) * RANGE_WIDTH + 1;
+			auto res = olympics.play_tournament(lowPower, lowPower + RANGE_WIDTH - 1);
+			++tournaments;
+			if (res.status() == StatusType::SUCCESS)
+			{
+				++succeeded;
+				checksum += res.ans();
+			}
+		}
+		else if (k < 95)
+		{
+			checksum += olympics.play_match(id(gen), id(gen)).ans();
+		}
+		else
+		{
+			int teamId = id(gen);
+			checksum += static_cast<int>(olympics.add_player(teamId, strength(gen)));
+			checksum += static_cast<int>(olympics.remove_newest_player(teamId));
+		}
+		samples.add(elapsedNs(start, BenchClock::now()));
+	}
+	if (succeeded != tournaments)
+	{
+		std::fprintf(stderr, "Only %d of %d tournaments succeeded, so the cache would be timed on failures\n",
+					 succeeded, tournaments);
+		std::exit(1);
+	}
+	
+	std::printf("%-10d %14.0f %10lld %10lld %10d %10d  (checksum %lld)\n", cacheCapacity, samples.opsPerSec(),
+				samples.percentile(0.5), samples.percentile(0.99),
+				cacheCapacity > 0 ? olympics.get_cache_hits() : 0, cacheCapacity > 0 ? olympics.get_cache_misses() : 0,
+				checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int numTeams = argc > 1 ? std::atoi(argv[1]) : 100000;
+	int numOps = argc > 2 ? std::atoi(argv[2]) : 100000;
+	int cacheCapacity = argc > 3 ? std::atoi(argv[3]) : 256;
+	if (numTeams < NUM_RANGES)
+	{
+		std::fprintf(stderr, "numTeams must be at least %d, one team per popular range\n", NUM_RANGES);
+		return 1;
+	}
+	
+	std::printf("%d teams, %d operations\n", numTeams, numOps);
+	std::printf("%-10s %14s %10s %10s %10s %10s\n", "cache", "ops/sec", "p50 (ns)", "p99 (ns)", "hits", "misses");
+	runIsolated([&]
+				{ run(numTeams, numOps, 0); });
+	runIsolated([&]
+				{ run(numTeams, numOps, cacheCapacity); });
+	return 0;
+}
@@ -0,0 +1,101 @@
+//
+// Write bursts on AVL_Tree with strict rebalancing and with relaxed balance + flush(): insert throughput during
+// the burst, the cost of the flush, and lookup cost before and after it.
+// Each burst inserts burstSize keys (sorted or random) into a tree of baseSize keys and then removes half of them,
+// like a roster import.
+//
+// Usage: RelaxedBalance_bench [baseSize] [numLookups]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+double lookupNs(const AVL_Tree<int, int>& tree, const std::vector<int>& lookups, long long& checksum)
+{
+	auto start = BenchClock::now();
+	for (int key : lookups)
+	{
+		auto res = tree.find(key);
+		checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+	}
+	return elapsedNs(start, BenchClock::now()) / static_cast<double>(lookups.size());
+}
+
+void run(const char* order, bool relaxed, int baseSize, const std::vector<int>& burst, const std::vector<int>& lookups)
+{
+	runIsolated([&]
+				{
+					AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+					for (int i = 0; i < baseSize; ++i)
+					{
+						tree.insert(2 * i, i);
+					}
+					long long checksum = 0;
+					tree.set_relaxed_balance(relaxed);
+					
+					auto start = BenchClock::now();
+					for (int key : burst)
+					{
+						tree.insert(key, key);
+					}
+					for (size_t i = 0; i < burst.size(); i += 2)
+					{
+						tree.remove(burst[i]);
+					}
+					double burstNs = elapsedNs(start, BenchClock::now()) / (burst.size() * 1.5);
+					int pending = relaxed ? tree.get_pending_rebalances() : 0;
+					double beforeFlushNs = lookupNs(tree, lookups, checksum);
+					
+					start = BenchClock::now();
+					tree.flush();
+					double flushMs = elapsedNs(start, BenchClock::now()) / 1e6;
+					double afterFlushNs = lookupNs(tree, lookups, checksum);
+					
+					std::printf("%-7s %-8s %9zu %14.1f %10d %10.2f %14.1f %13.1f  (checksum %lld)\n", order,
+								relaxed ? "relaxed" : "strict", burst.size(), burstNs, pending, flushMs,
+								beforeFlushNs, afterFlushNs, checksum);
+				});
+}
+
+int main(int argc, char** argv)
+{
+	int baseSize = argc > 1 ? std::atoi(argv[1]) : 100000;
+	int numLookups = argc > 2 ? std::atoi(argv[2]) : 1000000;
+	std::mt19937 gen(2024);
+	
+	std::printf("Bursts into a tree of %d keys, %d lookups\n", baseSize, numLookups);
+	std::printf("%-7s %-8s %9s %14s %10s %10s %14s %13s\n", "burst", "balance", "keys", "ns/update", "pending",
+				"flush (ms)", "lookup before", "lookup after");
+	for (int burstSize : {10000, 100000, 1000000})
+	{
+		// Odd keys, so the burst never collides with the base keys
+		std::vector<int> sorted(burstSize);
+		for (int i = 0; i < burstSize; ++i)
+		{
+			sorted[i] = 2 * (baseSize + i) + 1;
+		}
+		std::vector<int> shuffled = sorted;
+		std::shuffle(shuffled.begin(), shuffled.end(), gen);
+		std::uniform_int_distribution<int> key(0, 2 * (baseSize + burstSize));
+		std::vector<int> lookups(numLookups);
+		for (int& lookup : lookups)
+		{
+			lookup = key(gen);
+		}
+		
+		for (bool relaxed : {false, true})
+		{
+			run("sorted", relaxed, baseSize, sorted, lookups);
+		}
+		for (bool relaxed : {false, true})
+		{
+			run("random", relaxed, baseSize, shuffled, lookups);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,107 @@
+//
+// Cost of AVL_Tree::snapshot() compared to copying the tree with to_vec(), and the cost of inserts
+// while snapshots are held (path copying) compared to inserts into a tree with no snapshots.
+//
+// Usage: Snapshot_bench [maxSize]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../AVL_Tree.h"
+#include "BenchmarkUtils.h"
+
+// Inserts between two snapshots in the write overhead benchmark
+#define SNAPSHOT_INTERVAL 64
+
+std::vector<int> shuffledKeys(int n)
+{
+	std::vector<int> keys(n);
+	for (int i = 0; i < n; ++i)
+	{
+		keys[i] = i;
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(2024));
+	return keys;
+}
+
+void snapshotCost(int n)
+{
+	AVL_Tree<int, int> tree;
+	for (int key : shuffledKeys(n))
+	{
+		tree.insert(key, key);
+	}
+	
+	const int snapshotReps = 10000;
+	auto start = BenchClock::now();
+	long long checksum = 0;
+	for (int i = 0; i < snapshotReps; ++i)
+	{
+		auto snapshot = tree.snapshot();
+		checksum += snapshot.get_size();
+	}
+	double snapshotNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(snapshotReps);
+	
+	const int copyReps = 5;
+	start = BenchClock::now();
+	for (int i = 0; i < copyReps; ++i)
+	{
+		checksum += tree.to_vec().size();
+	}
+	double copyNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(copyReps);
+	
+	std::printf("%10d %16.1f %16.1f %10.1fx  (checksum %lld)\n", n, snapshotNs, copyNs, copyNs / snapshotNs,
+				checksum);
+}
+
+void writeOverhead(int n)
+{
+	std::vector<int> keys = shuffledKeys(n);
+	
+	AVL_Tree<int, int> plain;
+	auto start = BenchClock::now();
+	for (int key : keys)
+	{
+		plain.insert(key, key);
+	}
+	double plainNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(n);
+	
+	AVL_Tree<int, int> versioned;
+	auto snapshot = versioned.snapshot();
+	start = BenchClock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		if (i % SNAPSHOT_INTERVAL == 0)
+		{
+			snapshot = versioned.snapshot();
+		}
+		versioned.insert(keys[i], keys[i]);
+	}
+	double versionedNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(n);
+	
+	std::printf("%10d %16.1f %16.1f %10.2fx  (peak RSS %ld KB)\n", n, plainNs, versionedNs, versionedNs / plainNs,
+				peakRssKb());
+}
+
+int main(int argc, char** argv)
+{
+	int maxSize = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	
+	std::printf("Snapshot cost\n%10s %16s %16s %11s\n", "size", "snapshot (ns)", "to_vec (ns)", "speedup");
+	for (int n = 1000; n <= maxSize; n *= 10)
+	{
+		snapshotCost(n);
+	}
+	
+	std::printf("\nInsert cost, snapshot every %d inserts\n%10s %16s %16s %11s\n", SNAPSHOT_INTERVAL, "size",
+				"mutable (ns)", "versioned (ns)", "overhead");
+	for (int n = 1000; n <= maxSize; n *= 10)
+	{
+		runIsolated([n]
+					{ writeOverhead(n); });
+	}
+	return 0;
+}
@@ -0,0 +1,98 @@
+//
+// Standard library containers behind the HashTable / AVL_Tree interface, used as baselines in the benchmarks.
+//
+
+#ifndef DATASTRUCTURES2_STDADAPTERS_H
+#define DATASTRUCTURES2_STDADAPTERS_H
+
+#include <map>
+#include <unordered_map>
+#include "../../wet2util.h"
+
+// std::unordered_map with the HashTable interface
+template <class K, class V>
+class StdHashTable
+{
+public:
+	StatusType insert(const K& key, const V& value)
+	{
+		return map.emplace(key, value).second ? StatusType::SUCCESS : StatusType::FAILURE;
+	}
+	
+	StatusType remove(const K& key)
+	{
+		return map.erase(key) ? StatusType::SUCCESS : StatusType::FAILURE;
+	}
+	
+	output_t<V> find(const K& key) const
+	{
+		auto it = map.find(key);
+		if (it == map.end())
+		{
+			return StatusType::FAILURE;
+		}
+		return it->second;
+	}
+	
+	int get_size() const
+	{
+		return static_cast<int>(map.size());
+	}
+
+private:
+	std::unordered_map<K, V> map;
+};
+
+// std::map with the AVL_Tree interface
+template <class K, class V>
+class StdOrderedTree
+{
+public:
+	StatusType insert(const K& key, const V& value)
+	{
+		return map.emplace(key, value).second ? StatusType::SUCCESS : StatusType::FAILURE;
+	}
+	
+	StatusType remove(const K& key)
+	{
+		return map.erase(key) ? StatusType::SUCCESS : StatusType::FAILURE;
+	}
+	
+	output_t<V> find(const K& key) const
+	{
+		auto it = map.find(key);
+		if (it == map.end())
+		{
+			return StatusType::FAILURE;
+		}
+		return it->second;
+	}
+	
+	output_t<V> get_min() const
+	{
+		if (map.empty())
+		{
+			return StatusType::FAILURE;
+		}
+		return map.begin()->second;
+	}
+	
+	output_t<V> get_max() const
+	{
+		if (map.empty())
+		{
+			return StatusType::FAILURE;
+		}
+		return map.rbegin()->second;
+	}
+	
+	int get_size() const
+	{
+		return static_cast<int>(map.size());
+	}
+
+private:
+	std::map<K, V> map;
+};
+
+#endif //DATASTRUCTURES2_STDADAPTERS_H
@@ -0,0 +1,217 @@
+//
+// Per-match evaluation cost for team sizes 10..10^5.
+// Kernels: the strength aggregates of both teams of a match (sum, max and median) with the scalar and the AVX2
+// kernels of StrengthKernels.h. Player list: the same aggregates walking a linked list of individually allocated
+// players, as a Team walks its Player objects, against the AVX2 kernels. Olympics: play_match one call at a time
+// against play_matches in batches.
+//
+// Usage: StrengthKernels_bench [numMatches]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../olympics24a2.h"
+#include "../../StrengthKernels.h"
+#include "BenchmarkUtils.h"
+
+// Number of teams per size, so that the largest teams do not fit in the cache together
+#define NUM_TEAMS 32
+
+// Batch size for play_matches
+#define BATCH 256
+
+double kernelMatchNs(const std::vector<std::vector<int>>& teams, const std::vector<int>& pairs, long long& checksum)
+{
+	std::vector<int> scratch(teams[0].size());
+	auto start = BenchClock::now();
+	for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+	{
+		for (int team : {pairs[i], pairs[i + 1]})
+		{
+			const std::vector<int>& strengths = teams[team];
+			int n = static_cast<int>(strengths.size());
+			checksum += strengths_sum(strengths.data(), n);
+			checksum += strengths_max(strengths.data(), n);
+			checksum += strengths_median(strengths.data(), n, scratch.data());
+		}
+	}
+	return elapsedNs(start, BenchClock::now()) / (pairs.size() / 2.0);
+}
+
+// One player of a Team, allocated on its own like Player
+struct PlayerNode
+{
+	int strength;
+	PlayerNode* next;
+};
+
+// Builds one list per team. The nodes of all teams are allocated in a random order, so neighbours in a list are
+// not neighbours in memory, as after a long run of add_player and remove_newest_player calls.
+std::vector<PlayerNode*> buildPlayerLists(const std::vector<std::vector<int>>& teams, std::mt19937& gen)
+{
+	std::vector<std::pair<int, int>> order;
+	for (int team = 0; team < static_cast<int>(teams.size()); ++team)
+	{
+		for (int i = 0; i < static_cast<int>(teams[team].size()); ++i)
+		{
+			order.emplace_back(team, i);
+		}
+	}
+	std::shuffle(order.begin(), order.end(), gen);
+	std::vector<std::vector<PlayerNode*>> nodes(teams.size());
+	for (size_t team = 0; team < teams.size(); ++team)
+	{
+		nodes[team].resize(teams[team].size());
+	}
+	for (const auto& player : order)
+	{
+		nodes[player.first][player.second] = new PlayerNode{teams[player.first][player.second], nullptr};
+	}
+	std::vector<PlayerNode*> heads(teams.size(), nullptr);
+	for (size_t team = 0; team < teams.size(); ++team)
+	{
+		for (size_t i = nodes[team].size(); i-- > 0;)
+		{
+			nodes[team][i]->next = heads[team];
+			heads[team] = nodes[team][i];
+		}
+	}
+	return heads;
+}
+
+void freePlayerLists(std::vector<PlayerNode*>& heads)
+{
+	for (PlayerNode*& head : heads)
+	{
+		while (head)
+		{
+			PlayerNode* next = head->next;
+			delete head;
+			head = next;
+		}
+	}
+}
+
+// Sum, max and median by walking the players, copying the strengths out for the median
+double pointerWalkMatchNs(const std::vector<PlayerNode*>& heads, const std::vector<int>& pairs, long long& checksum)
+{
+	std::vector<int> scratch;
+	auto start = BenchClock::now();
+	for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+	{
+		for (int team : {pairs[i], pairs[i + 1]})
+		{
+			long long sum = 0;
+			int max = 0;
+			scratch.clear();
+			for (const PlayerNode* node = heads[team]; node; node = node->next)
+			{
+				sum += node->strength;
+				max = std::max(max, node->strength);
+				scratch.push_back(node->strength);
+			}
+			auto median = scratch.begin() + (scratch.size() - 1) / 2;
+			std::nth_element(scratch.begin(), median, scratch.end());
+			checksum += sum + max + *median;
+		}
+	}
+	return elapsedNs(start, BenchClock::now()) / (pairs.size() / 2.0);
+}
+
+void runOlympics(int teamSize, const std::vector<int>& pairs, const std::vector<std::vector<int>>& teams)
+{
+	runIsolated([&]
+				{
+					olympics_t olympics;
+					for (int team = 0; team < NUM_TEAMS; ++team)
+					{
+						olympics.add_team(team + 1);
+						for (int s : teams[team])
+						{
+							olympics.add_player(team + 1, s);
+						}
+					}
+					std::vector<int> ids1;
+					std::vector<int> ids2;
+					for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+					{
+						ids1.push_back(pairs[i] + 1);
+						ids2.push_back(pairs[i + 1] + 1);
+					}
+					int numMatches = static_cast<int>(ids1.size());
+					long long checksum = 0;
+					
+					auto start = BenchClock::now();
+					for (int i = 0; i < numMatches; ++i)
+					{
+						auto res = olympics.play_match(ids1[i], ids2[i]);
+						checksum += res.status() == StatusType::SUCCESS ? res.ans() : 0;
+					}
+					double singleNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(numMatches);
+					
+					std::vector<output_t<int>> results(BATCH);
+					start = BenchClock::now();
+					for (int i = 0; i + BATCH <= numMatches; i += BATCH)
+					{
+						olympics.play_matches(ids1.data() + i, ids2.data() + i, BATCH, results.data());
+						for (auto& res : results)
+						{
+							checksum -= res.status() == StatusType::SUCCESS ? res.ans() : 0;
+						}
+					}
+					int batched = numMatches / BATCH * BATCH;
+					double batchNs = elapsedNs(start, BenchClock::now()) / static_cast<double>(batched);
+					
+					std::printf("%-9d %-22s %12.1f %12.1f %9.2fx  (checksum %lld)\n", teamSize, "play_match / batch",
+								singleNs, batchNs, singleNs / batchNs, checksum);
+				});
+}
+
+int main(int argc, char** argv)
+{
+	int numMatches = argc > 1 ? std::atoi(argv[1]) : 100000;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> strength(1, 1000000);
+	std::uniform_int_distribution<int> team(0, NUM_TEAMS - 1);
+	std::vector<int> pairs(2 * numMatches);
+	for (int& t : pairs)
+	{
+		t = team(gen);
+	}
+	
+	std::printf("%d matches between %d teams, times in ns per match\n", numMatches, NUM_TEAMS);
+	std::printf("%-9s %-22s %12s %12s %10s\n", "team size", "evaluation", "baseline", "vectorized", "speedup");
+	for (int teamSize : {10, 100, 1000, 10000, 100000})
+	{
+		std::vector<std::vector<int>> teams(NUM_TEAMS, std::vector<int>(teamSize));
+		for (auto& strengths : teams)
+		{
+			for (int& s : strengths)
+			{
+				s = strength(gen);
+			}
+		}
+		// Fewer matches for big teams, so every size takes about as long
+		int sizedMatches = std::min(numMatches, std::max(BATCH, numMatches / teamSize * 10));
+		std::vector<int> sizedPairs(pairs.begin(), pairs.begin() + 2 * sizedMatches);
+		long long checksum = 0;
+		select_kernels(KernelIsa::SCALAR);
+		double scalarNs = kernelMatchNs(teams, sizedPairs, checksum);
+		bool hasAvx2 = select_kernels(KernelIsa::AVX2) == KernelIsa::AVX2;
+		double avx2Ns = kernelMatchNs(teams, sizedPairs, checksum);
+		std::printf("%-9d %-22s %12.1f %12.1f %9.2fx  (checksum %lld)%s\n", teamSize, "sum + max + median", scalarNs,
+					avx2Ns, scalarNs / avx2Ns, checksum, hasAvx2 ? "" : "  (no AVX2, scalar twice)");
+		std::vector<PlayerNode*> heads = buildPlayerLists(teams, gen);
+		long long walkChecksum = 0;
+		double walkNs = pointerWalkMatchNs(heads, sizedPairs, walkChecksum);
+		freePlayerLists(heads);
+		std::printf("%-9d %-22s %12.1f %12.1f %9.2fx  (checksum %lld)\n", teamSize, "Player list / kernels",
+					walkNs, avx2Ns, walkNs / avx2Ns, walkChecksum);
+		runOlympics(teamSize, sizedPairs, teams);
+	}
+	return 0;
+}
@@ -0,0 +1,83 @@
+//
+// Latency of reading the k strongest teams through olympics_t::top_k(k) compared to a read-only walk over k nodes
+// of a balanced tree holding the keys of teamsByStrength, and the cost top_k maintenance adds to add_player.
+//
+// AVL_Tree has no predecessor query, so the walk runs on a std::map copy of the teamsByStrength keys: it starts
+// at the largest key and steps to the predecessor k - 1 times, chasing the same kind of node pointers.
+//
+// Usage: TopK_bench [numTeams] [reads]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+#include "../../olympics24a2.h"
+#include "BenchmarkUtils.h"
+
+int main(int argc, char** argv)
+{
+	int numTeams = argc > 1 ? std::atoi(argv[1]) : 100000;
+	int reads = argc > 2 ? std::atoi(argv[2]) : 100000;
+	
+	olympics_t olympics;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> strength(1, 1000);
+	std::uniform_int_distribution<int> id(1, numTeams);
+	for (int teamId = 1; teamId <= numTeams; ++teamId)
+	{
+		olympics.add_team(teamId);
+	}
+	
+	LatencySamples addPlayer;
+	for (int i = 0; i < numTeams; ++i)
+	{
+		int teamId = id(gen);
+		int playerStrength = strength(gen);
+		auto start = BenchClock::now();
+		olympics.add_player(teamId, playerStrength);
+		addPlayer.add(elapsedNs(start, BenchClock::now()));
+	}
+	
+	std::printf("%d teams, add_player p50 %lld ns, p99 %lld ns\n", numTeams, addPlayer.percentile(0.5),
+				addPlayer.percentile(0.99));
+	std::map<Pair<int, int>, int> byStrength;
+	for (const auto& pair : olympics.teamsByStrength.to_vec())
+	{
+		byStrength.emplace(pair.get_first(), pair.get_first().get_first());
+	}
+	
+	std::printf("%6s %16s %16s %16s %16s\n", "k", "top_k p50 (ns)", "top_k p99 (ns)", "walk p50 (ns)",
+				"walk p99 (ns)");
+	for (int k : {1, 10, 16})
+	{
+		LatencySamples topK;
+		long long checksum = 0;
+		for (int i = 0; i < reads; ++i)
+		{
+			auto start = BenchClock::now();
+			const auto& top = olympics.top_k(k);
+			checksum += top[0];
+			topK.add(elapsedNs(start, BenchClock::now()));
+		}
+		
+		LatencySamples walk;
+		int ids[16];
+		for (int i = 0; i < reads; ++i)
+		{
+			auto start = BenchClock::now();
+			int walked = 0;
+			for (auto it = byStrength.rbegin(); it != byStrength.rend() && walked < k; ++it)
+			{
+				ids[walked++] = it->second;
+			}
+			walk.add(elapsedNs(start, BenchClock::now()));
+			checksum += ids[0];
+		}
+		
+		std::printf("%6d %16lld %16lld %16lld %16lld  (checksum %lld)\n", k, topK.percentile(0.5),
+					topK.percentile(0.99), walk.percentile(0.5), walk.percentile(0.99), checksum);
+	}
+	return 0;
+}
@@ -3,8 +3,16 @@
 //
 #include "gtest/gtest.h"
 #include "../../HashTable.h"
+#ifdef DS2_TEST_CUCKOO_HASH
+#include "../../CuckooHashTable.h"
+#endif
 #include "../utils.h"
+#include "../AllocationTracker.h"
 
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
 #include <vector>
 #include <utility>
 
@@ -35,18 +43,27 @@ std::string errMsg(opType op, S operand, T valExp, T valActual);
 
 #define SUITE HashTableTest
 
+// The table under test. Blackbox_cuckoo_test builds this file again with HASH_TABLE_UNDER_TEST=CuckooHashTable and
+// DS2_CUCKOO_BACKEND, which leaves out the tests of the HashTable-only features (HASH_FIND_MANY, MEMORY_POLICY and
+// HASH_MISS_FILTER), so CuckooHashTable only needs the core interface.
+#ifndef HASH_TABLE_UNDER_TEST
+#define HASH_TABLE_UNDER_TEST HashTable
+#endif
+template <class K, class V>
+using TestedHashTable = HASH_TABLE_UNDER_TEST<K, V>;
+
 // Fixture for HashTable tests with empty table
 class EmptyHashTable : public ::testing::Test
 {
 protected:
-	HashTable<int, int> table;
+	TestedHashTable<int, int> table;
 };
 
 // Fixture for HashTable tests with pre-inserted elements
 class HashTableWithElements : public ::testing::Test
 {
 protected:
-	HashTable<int, int> table;
+	TestedHashTable<int, int> table;
 	
 	void SetUp() override
 	{
@@ -61,9 +78,9 @@ protected:
 class HashTableWithCollisions : public ::testing::Test
 {
 protected:
-	HashTable<int, int> emptyTable;
+	TestedHashTable<int, int> emptyTable;
 	
-	HashTable<int, int> table;
+	TestedHashTable<int, int> table;
 	
 	std::vector<std::pair<int, int>> inputs;
 	
@@ -88,7 +105,7 @@ protected:
 // Test insertion of new elements
 TEST(SUITE, Insertion_NewElement)
 {
-	HashTable<int, int> emptyTable;
+	TestedHashTable<int, int> emptyTable;
 	
 	// Insertion of 20 new elements
 	for (int i = 0; i < 20; ++i)
@@ -153,7 +170,7 @@ TEST_F(EmptyHashTable, Removal_NonExistentElement)
 TEST_F(EmptyHashTable, Removal_EmptyTable)
 {
 	// Attempt to remove from an empty table
-	HashTable<int, int> emptyTable;
+	TestedHashTable<int, int> emptyTable;
 	auto res = emptyTable.remove(5);
 	auto expected = FAILURE;
 	EXPECT_EQ(res, expected) << errMsg(REMOVE, 5, expected, res);
@@ -184,7 +201,7 @@ TEST_F(EmptyHashTable, Find_NonExistentElement)
 TEST_F(EmptyHashTable, Find_EmptyTable)
 {
 	// Test finding on an empty table
-	HashTable<int, int> emptyTable;
+	TestedHashTable<int, int> emptyTable;
 	auto emptyResult = emptyTable.find(5);
 	auto expected = FAILURE;
 	EXPECT_EQ(emptyResult.status(), expected) << errMsg(FIND, 5, expected, emptyResult.status());
@@ -315,87 +332,492 @@ TEST_F(HashTableWithElements, FindOnEmptyTable)
 	EXPECT_EQ(res3.status(), FAILURE) << errMsg(FIND, 25, FAILURE, res3.status());
 	EXPECT_EQ(res4.status(), FAILURE) << errMsg(FIND, 30, FAILURE, res4.status());}
 
-template <typename T, typename S>
-std::string errMsg(opType op, S operand, StatusType expected, StatusType actual, T valActual, T valExp)
+#if defined(DS2_TEST_HASH_FIND_MANY) && !defined(DS2_CUCKOO_BACKEND)
+// find_many(keys, n, out) and contains_many(keys, n, out) must give the same answers as n calls to find().
+// out points to n constructed elements. output_t is not assignable, so find_many destroys each out[i] and
+// placement-constructs the answer in its place.
+
+// Test batched finding of existing and non-existent elements
+TEST_F(HashTableWithElements, FindMany_MixedElements)
 {
-	std::string opStr;
-	switch (op)
+	std::vector<int> keys;
+	for (int i = 39; i >= 0; --i)
 	{
-		case INSERT:
-			opStr = "Insertion";
-			break;
-		case REMOVE:
-			opStr = "Removal";
-			break;
-		case FIND:
-			opStr = "Finding";
-			break;
-		default:
-			return "";
+		keys.push_back(i);
 	}
-	std::string msg = opStr + " of " + str(operand) + " failed.";
-	if (expected != actual)
+	std::vector<output_t<int>> results(keys.size());
+	table.find_many(keys.data(), keys.size(), results.data());
+	for (size_t i = 0; i < keys.size(); ++i)
 	{
-		msg += "Expected result " + str(expected) + ", Actual: " + str(actual) + "\n";
+		auto expected = table.find(keys[i]);
+		EXPECT_EQ(results[i].status(), expected.status())
+							<< errMsg(FIND, keys[i], expected.status(), results[i].status());
+		if (expected.status() == SUCCESS)
+		{
+			EXPECT_EQ(results[i].ans(), expected.ans()) << errMsg(FIND, keys[i], expected.ans(), results[i].ans());
+		}
 	}
-	if (valExp != valActual)
+}
+
+// Test batched finding with repeated keys in the same batch
+TEST_F(HashTableWithElements, FindMany_DuplicateKeys)
+{
+	std::vector<int> keys = {3, 3, 25, 3, 25, 19, 0, 0};
+	std::vector<output_t<int>> results(keys.size());
+	table.find_many(keys.data(), keys.size(), results.data());
+	for (size_t i = 0; i < keys.size(); ++i)
 	{
-		msg += "Expected value: " + str(valExp) + ", Actual: " + str(valActual);
+		auto expectedStatus = keys[i] < 20 ? SUCCESS : FAILURE;
+		EXPECT_EQ(results[i].status(), expectedStatus) << errMsg(FIND, keys[i], expectedStatus, results[i].status());
+		if (expectedStatus == SUCCESS)
+		{
+			EXPECT_EQ(results[i].ans(), keys[i] * 10) << errMsg(FIND, keys[i], keys[i] * 10, results[i].ans());
+		}
 	}
-	return msg;
 }
 
-template <typename S>
-std::string errMsg(opType op, S operand, StatusType expected, StatusType actual)
+// Test batched finding on an empty table and with an empty batch
+TEST_F(EmptyHashTable, FindMany_EmptyTable)
 {
-	std::string opStr;
-	switch (op)
+	std::vector<int> keys = {0, 1, 2, 5, 25};
+	std::vector<output_t<int>> results(keys.size());
+	table.find_many(keys.data(), keys.size(), results.data());
+	for (size_t i = 0; i < keys.size(); ++i)
 	{
-		case INSERT:
-			opStr = "Insertion";
-			break;
-		case REMOVE:
-			opStr = "Removal";
-			break;
-		case FIND:
-			opStr = "Finding";
-			break;
-		default:
-			return "";
+		EXPECT_EQ(results[i].status(), FAILURE) << errMsg(FIND, keys[i], FAILURE, results[i].status());
 	}
-	std::string msg = opStr + " of " + str(operand) + " failed.";
-	if (expected != actual)
+	table.find_many(keys.data(), 0, results.data());
+}
+
+// Test batched finding of elements causing collisions
+TEST_F(HashTableWithCollisions, FindMany_WithCollisions)
+{
+	// Each key is followed by an absent key with the same low 20 bits. HashTable's modulus is not specified, so the
+	// two may or may not share a bucket; the answers must be right either way.
+	std::vector<int> keys;
+	for (auto pair : inputs)
+	{
+		keys.push_back(pair.first);
+		keys.push_back(pair.first + (1 << 20));
+	}
+	std::vector<output_t<int>> results(keys.size());
+	table.find_many(keys.data(), keys.size(), results.data());
+	for (size_t i = 0; i < inputs.size(); ++i)
 	{
-		msg += "Expected result " + str(expected) + ", Actual: " + str(actual) + "\n";
+		auto& found = results[2 * i];
+		auto& missing = results[2 * i + 1];
+		EXPECT_EQ(found.status(), SUCCESS) << errMsg(FIND, inputs[i].first, SUCCESS, found.status());
+		EXPECT_EQ(found.ans(), inputs[i].second) << errMsg(FIND, inputs[i].first, inputs[i].second, found.ans());
+		EXPECT_EQ(missing.status(), FAILURE) << errMsg(FIND, keys[2 * i + 1], FAILURE, missing.status());
 	}
-	return msg;
 }
 
-template <typename T, typename S>
-std::string errMsg(opType op, S operand, T valExp, T valActual)
+// Test batched membership checks
+TEST_F(HashTableWithCollisions, ContainsMany_WithCollisions)
+{
+	// Each key is followed by an absent key with the same low 20 bits. HashTable's modulus is not specified, so the
+	// two may or may not share a bucket; the answers must be right either way.
+	std::vector<int> keys;
+	for (auto pair : inputs)
+	{
+		keys.push_back(pair.first);
+		keys.push_back(pair.first + (1 << 20));
+	}
+	std::unique_ptr<bool[]> results(new bool[keys.size()]);
+	table.contains_many(keys.data(), keys.size(), results.get());
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		EXPECT_EQ(results[i], i % 2 == 0) << "Finding of " << keys[i] << " failed.";
+	}
+}
+#endif
+
+#if defined(DS2_TEST_MEMORY_POLICY) && !defined(DS2_CUCKOO_BACKEND)
+// set_memory_policy(hugePages, numaNode) chooses how an empty table allocates its bucket arrays (numaNode -1 for
+// no binding). It must fall back to normal allocation when huge pages or NUMA are unavailable, so it succeeds
+// on any machine. It is FAILURE on a non-empty table and INVALID_INPUT for a numaNode below -1.
+
+// Test that a table behaves the same with every memory policy, including a NUMA node that does not exist
+TEST(SUITE, MemoryPolicy_SameBehaviour)
+{
+	for (int numaNode : {-1, 0, 1000})
+	{
+		for (bool hugePages : {false, true})
+		{
+			TestedHashTable<int, int> table;
+			EXPECT_EQ(table.set_memory_policy(hugePages, numaNode), SUCCESS);
+			for (int i = 0; i < 10000; ++i)
+			{
+				auto res = table.insert(i, i * 10);
+				EXPECT_EQ(res, SUCCESS) << errMsg(INSERT, i, SUCCESS, res);
+			}
+			for (int i = 0; i < 10000; i += 2)
+			{
+				auto res = table.remove(i);
+				EXPECT_EQ(res, SUCCESS) << errMsg(REMOVE, i, SUCCESS, res);
+			}
+			for (int i = 0; i < 10000; ++i)
+			{
+				auto result = table.find(i);
+				auto expectedStatus = i % 2 ? SUCCESS : FAILURE;
+				EXPECT_EQ(result.status(), expectedStatus) << errMsg(FIND, i, expectedStatus, result.status());
+				if (expectedStatus == SUCCESS)
+				{
+					EXPECT_EQ(result.ans(), i * 10) << errMsg(FIND, i, i * 10, result.ans());
+				}
+			}
+			EXPECT_EQ(table.get_size(), 5000);
+		}
+	}
+}
+
+// Test that the policy can only be chosen before the first insertion, and only for valid nodes
+TEST_F(HashTableWithElements, MemoryPolicy_NonEmptyTable)
+{
+	EXPECT_EQ(table.set_memory_policy(true, -1), FAILURE);
+	TestedHashTable<int, int> emptyTable;
+	EXPECT_EQ(emptyTable.set_memory_policy(true, -2), INVALID_INPUT);
+	for (int i = 0; i < 20; ++i)
+	{
+		auto result = table.find(i);
+		EXPECT_EQ(result.status(), SUCCESS) << errMsg(FIND, i, SUCCESS, result.status());
+	}
+}
+
+// Test that both heap memory and pages mapped by the table itself are given back under the huge page policy
+TEST(SUITE, MemoryPolicy_NoLeaks)
+{
+	AllocationScope scope;
+	{
+		TestedHashTable<int, int> table;
+		EXPECT_EQ(table.set_memory_policy(true, -1), SUCCESS);
+		for (int i = 0; i < 100000; ++i)
+		{
+			table.insert(i, i);
+		}
+		EXPECT_GT(scope.liveBytes() + scope.mappedBytes(), 0);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.mappedBytes(), 0);
+}
+#endif
+
+#ifdef DS2_TEST_CUCKOO_HASH
+// Adversarial inputs for the cuckoo backend: inserts that fail must rehash with new seeds instead of failing.
+// These run against both HashTable and CuckooHashTable.
+
+// Test insertion of keys that share their low bits, so they collide under simple modular hashing
+TEST(SUITE, Insertion_SameLowBits)
+{
+	TestedHashTable<int, int> table;
+	for (int i = 0; i < 20000; ++i)
+	{
+		auto res = table.insert(i << 12, i);
+		EXPECT_EQ(res, SUCCESS) << errMsg(INSERT, i << 12, SUCCESS, res);
+	}
+	EXPECT_EQ(table.get_size(), 20000);
+	for (int i = 0; i < 20000; ++i)
+	{
+		auto result = table.find(i << 12);
+		EXPECT_EQ(result.status(), SUCCESS) << errMsg(FIND, i << 12, SUCCESS, result.status());
+		EXPECT_EQ(result.ans(), i) << errMsg(FIND, i << 12, i, result.ans());
+		auto missing = table.find((i << 12) + 1);
+		EXPECT_EQ(missing.status(), FAILURE) << errMsg(FIND, (i << 12) + 1, FAILURE, missing.status());
+	}
+}
+
+// Test a long insert/remove churn, which keeps displacing entries between their two buckets
+TEST(SUITE, InsertRemoveChurn)
+{
+	TestedHashTable<int, int> table;
+	for (int round = 0; round < 20; ++round)
+	{
+		for (int i = 0; i < 5000; ++i)
+		{
+			auto res = table.insert(round * 5000 + i, i);
+			EXPECT_EQ(res, SUCCESS) << errMsg(INSERT, round * 5000 + i, SUCCESS, res);
+		}
+		for (int i = 0; i < 5000; i += 2)
+		{
+			auto res = table.remove(round * 5000 + i);
+			EXPECT_EQ(res, SUCCESS) << errMsg(REMOVE, round * 5000 + i, SUCCESS, res);
+		}
+	}
+	EXPECT_EQ(table.get_size(), 20 * 2500);
+	for (int key = 0; key < 20 * 5000; ++key)
+	{
+		auto result = table.find(key);
+		auto expected = key % 2 ? SUCCESS : FAILURE;
+		EXPECT_EQ(result.status(), expected) << errMsg(FIND, key, expected, result.status());
+	}
+}
+#endif
+
+#if defined(DS2_TEST_HASH_MISS_FILTER) && !defined(DS2_CUCKOO_BACKEND)
+// set_miss_filter(falsePositiveRate) puts a deletable membership filter (counting Bloom or quotient filter) in front
+// of an empty table. find and remove of a key the filter rules out return FAILURE without touching the buckets,
+// and get_filter_rejections() counts them. get_filter_bytes() is the memory the filter uses (0 without one).
+// These always run against HashTable, which backs teamsHashTable.
+
+// Bytes of filter per key allowed for a given false positive rate: an optimal Bloom filter needs 1.44 * log2(1 / p)
+// counters per key, so with 4-bit counters 0.72 * log2(1 / p) bytes per key, doubled for a filter that just grew
+static double maxFilterBytesPerKey(double falsePositiveRate)
+{
+	return 2 * 0.72 * std::log2(1 / falsePositiveRate);
+}
+
+// Test that the filter only rejects keys that are not in the table, over a random mix of operations
+TEST(SUITE, MissFilter_SameAnswers)
+{
+	HashTable<int, int> filtered;
+	HashTable<int, int> plain;
+	EXPECT_EQ(filtered.set_miss_filter(0.01), SUCCESS);
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> key(0, 20000);
+	std::uniform_int_distribution<int> kind(0, 2);
+	for (int i = 0; i < 100000; ++i)
+	{
+		int k = key(gen);
+		switch (kind(gen))
+		{
+			case INSERT:
+			{
+				auto expected = plain.insert(k, i);
+				auto res = filtered.insert(k, i);
+				EXPECT_EQ(res, expected) << errMsg(INSERT, k, expected, res);
+				break;
+			}
+			case REMOVE:
+			{
+				auto expected = plain.remove(k);
+				auto res = filtered.remove(k);
+				EXPECT_EQ(res, expected) << errMsg(REMOVE, k, expected, res);
+				break;
+			}
+			default:
+			{
+				auto expected = plain.find(k);
+				auto result = filtered.find(k);
+				EXPECT_EQ(result.status(), expected.status()) << errMsg(FIND, k, expected.status(), result.status());
+				if (expected.status() == SUCCESS)
+				{
+					EXPECT_EQ(result.ans(), expected.ans()) << errMsg(FIND, k, expected.ans(), result.ans());
+				}
+			}
+		}
+	}
+	EXPECT_EQ(filtered.get_size(), plain.get_size());
+}
+
+// Test that almost all misses are answered by the filter, and hits never are
+TEST(SUITE, MissFilter_RejectsMisses)
+{
+	const double rate = 0.01;
+	const int n = 50000;
+	HashTable<int, int> table;
+	EXPECT_EQ(table.set_miss_filter(rate), SUCCESS);
+	for (int i = 0; i < n; ++i)
+	{
+		table.insert(2 * i, i);
+	}
+	EXPECT_EQ(table.get_filter_rejections(), 0);
+	
+	for (int i = 0; i < n; ++i)
+	{
+		auto result = table.find(2 * i);
+		EXPECT_EQ(result.status(), SUCCESS) << errMsg(FIND, 2 * i, SUCCESS, result.status());
+	}
+	EXPECT_EQ(table.get_filter_rejections(), 0);
+	
+	for (int i = 0; i < n; ++i)
+	{
+		auto result = table.find(2 * i + 1);
+		EXPECT_EQ(result.status(), FAILURE) << errMsg(FIND, 2 * i + 1, FAILURE, result.status());
+	}
+	EXPECT_GE(table.get_filter_rejections(), (1 - 3 * rate) * n);
+	
+	long long rejections = table.get_filter_rejections();
+	for (int i = 0; i < n; ++i)
+	{
+		auto res = table.remove(2 * i + 1);
+		EXPECT_EQ(res, FAILURE) << errMsg(REMOVE, 2 * i + 1, FAILURE, res);
+	}
+	EXPECT_GE(table.get_filter_rejections() - rejections, (1 - 3 * rate) * n);
+}
+
+// Test that removed keys leave the filter, so they are rejected again and can be inserted again
+TEST(SUITE, MissFilter_AfterRemove)
+{
+	const double rate = 0.01;
+	const int n = 50000;
+	HashTable<int, int> table;
+	EXPECT_EQ(table.set_miss_filter(rate), SUCCESS);
+	for (int i = 0; i < n; ++i)
+	{
+		table.insert(i, i);
+	}
+	for (int i = 0; i < n; i += 2)
+	{
+		auto res = table.remove(i);
+		EXPECT_EQ(res, SUCCESS) << errMsg(REMOVE, i, SUCCESS, res);
+	}
+	
+	long long rejections = table.get_filter_rejections();
+	for (int i = 0; i < n; i += 2)
+	{
+		auto result = table.find(i);
+		EXPECT_EQ(result.status(), FAILURE) << errMsg(FIND, i, FAILURE, result.status());
+	}
+	EXPECT_GE(table.get_filter_rejections() - rejections, (1 - 3 * rate) * n / 2);
+	
+	for (int i = 0; i < n; i += 2)
+	{
+		auto res = table.insert(i, -i);
+		EXPECT_EQ(res, SUCCESS) << errMsg(INSERT, i, SUCCESS, res);
+	}
+	for (int i = 0; i < n; ++i)
+	{
+		auto result = table.find(i);
+		int expected = i % 2 ? i : -i;
+		EXPECT_EQ(result.status(), SUCCESS) << errMsg(FIND, i, SUCCESS, result.status());
+		EXPECT_EQ(result.ans(), expected) << errMsg(FIND, i, expected, result.ans());
+	}
+}
+
+// Test that the filter memory follows the requested false positive rate
+TEST(SUITE, MissFilter_Memory)
+{
+	const int n = 100000;
+	HashTable<int, int> plain;
+	EXPECT_EQ(plain.get_filter_bytes(), 0);
+	long long previousBytes = 0;
+	for (double rate : {0.1, 0.01, 0.001})
+	{
+		HashTable<int, int> table;
+		EXPECT_EQ(table.set_miss_filter(rate), SUCCESS);
+		for (int i = 0; i < n; ++i)
+		{
+			table.insert(i, i);
+		}
+		long long bytes = table.get_filter_bytes();
+		EXPECT_GT(bytes, 0) << "False positive rate " << rate;
+		EXPECT_LE(bytes, maxFilterBytesPerKey(rate) * n + 4096) << "False positive rate " << rate;
+		EXPECT_GE(bytes, previousBytes) << "A lower false positive rate (" << rate << ") uses less memory";
+		previousBytes = bytes;
+	}
+}
+
+// Test that the filter can only be added to an empty table, with a rate strictly between 0 and 1
+TEST(SUITE, MissFilter_InvalidInput)
+{
+	HashTable<int, int> table;
+	for (int i = 0; i < 20; ++i)
+	{
+		table.insert(i, i * 10);
+	}
+	EXPECT_EQ(table.set_miss_filter(0.01), FAILURE);
+	HashTable<int, int> emptyTable;
+	EXPECT_EQ(emptyTable.set_miss_filter(0), INVALID_INPUT);
+	EXPECT_EQ(emptyTable.set_miss_filter(1), INVALID_INPUT);
+	EXPECT_EQ(emptyTable.set_miss_filter(-0.5), INVALID_INPUT);
+	for (int i = 0; i < 20; ++i)
+	{
+		auto result = table.find(i);
+		EXPECT_EQ(result.status(), SUCCESS) << errMsg(FIND, i, SUCCESS, result.status());
+	}
+}
+
+// Test that a filtered table returns all of its memory once destroyed
+TEST(SUITE, MissFilter_NoLeaks)
+{
+	AllocationScope scope;
+	{
+		HashTable<int, int> table;
+		EXPECT_EQ(table.set_miss_filter(0.01), SUCCESS);
+		for (int i = 0; i < 10000; ++i)
+		{
+			table.insert(i, i);
+		}
+		for (int i = 0; i < 10000; i += 2)
+		{
+			table.remove(i);
+		}
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+}
+#endif
+
+// Test that a table returns all of its memory once destroyed
+TEST(SUITE, NoLeaks)
+{
+	AllocationScope scope;
+	{
+		TestedHashTable<int, int> table;
+		for (int i = 0; i < 1000; ++i)
+		{
+			auto res = table.insert(i, i * 10);
+			EXPECT_EQ(res, SUCCESS) << errMsg(INSERT, i, SUCCESS, res);
+		}
+		for (int i = 0; i < 1000; i += 2)
+		{
+			auto res = table.remove(i);
+			EXPECT_EQ(res, SUCCESS) << errMsg(REMOVE, i, SUCCESS, res);
+		}
+		EXPECT_GT(scope.liveBytes(), 0);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+
+std::string opTypeToString(opType op)
 {
-	std::string opStr;
 	switch (op)
 	{
 		case INSERT:
-			opStr = "Insertion";
-			break;
+			return "Insertion";
 		case REMOVE:
-			opStr = "Removal";
-			break;
+			return "Removal";
 		case FIND:
-			opStr = "Finding";
-			break;
+			return "Finding";
 		default:
 			return "";
 	}
-	std::string msg = opStr + " of " + str(operand) + " failed.";
+}
+
+// Messages are only built when the assertion they are streamed into fails
+template <typename T, typename S>
+std::string errMsg(opType op, S operand, StatusType expected, StatusType actual, T valActual, T valExp)
+{
+	std::ostringstream msg;
+	msg << errMsg(op, operand, expected, actual);
 	if (valExp != valActual)
 	{
-		msg += "Expected value: " + str(valExp) + ", Actual: " + str(valActual);
+		msg << "Expected value: " << str(valExp) << ", Actual: " << str(valActual) << "\n";
 	}
-	return msg;
+	return msg.str();
 }
 
+template <typename S>
+std::string errMsg(opType op, S operand, StatusType expected, StatusType actual)
+{
+	std::ostringstream msg;
+	msg << opTypeToString(op) << " of " << str(operand) << " failed.\n";
+	if (expected != actual)
+	{
+		msg << "Expected result " << status_type_strings[static_cast<int>(expected)] << ", Actual: "
+			<< status_type_strings[static_cast<int>(actual)] << "\n";
+	}
+	return msg.str();
+}
 
-
+template <typename T, typename S>
+std::string errMsg(opType op, S operand, T valExp, T valActual)
+{
+	std::ostringstream msg;
+	msg << opTypeToString(op) << " of " << str(operand) << " failed.\n";
+	if (valExp != valActual)
+	{
+		msg << "Expected value: " << str(valExp) << ", Actual: " << str(valActual) << "\n";
+	}
+	return msg.str();
+}
@@ -4,9 +4,14 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
 #include "../../olympics24a2.h"
 #include "OlympicsTestUtils.h"
 #include "OlympicsTestFixtures.h"
+#include "../AllocationTracker.h"
 
 // Test case to add teams with valid teamIds in an empty Olympics instance
 TEST_F(EmptyOlympics, AddTeamsValidIds)
@@ -203,3 +208,781 @@ TEST_F(InitializedOlympicsTeamsOnly, AddMultiplePlayersToTeam)
 	EXPECT_EQ(res2, expectedRes) << errMsg(ADD_PLAYER, std::make_pair(teamId, playerStrength2), expectedRes, res2);
 }
 
+// Test case to check that removing all teams gives back the memory used by the teams and their players
+TEST_F(InitializedOlympicsTeamsOnly, RemoveAllTeamsReleasesMemory)
+{
+	// Arrange
+	// One full removal first, so the containers are measured at the same capacity before and after
+	for (int teamId : existingIds)
+	{
+		olympics.remove_team(teamId);
+	}
+	AllocationScope scope;
+	
+	// Act
+	for (int teamId : existingIds)
+	{
+		olympics.add_team(teamId);
+		olympics.add_player(teamId, 50);
+		olympics.add_player(teamId, 60);
+	}
+	for (int teamId : existingIds)
+	{
+		const auto res = olympics.remove_team(teamId);
+		EXPECT_EQ(res, SUCCESS) << errMsg(REMOVE_TEAM, teamId, SUCCESS, res);
+	}
+	
+	// Assert
+	EXPECT_LE(scope.liveBytes(), 0); // No memory is still held for the removed teams and players
+}
+
+// Test case to check that an Olympics instance gives back all of its memory once destroyed
+TEST_F(EmptyOlympics, DestructorReleasesMemory)
+{
+	// Arrange
+	AllocationScope scope;
+	
+	// Act
+	{
+		olympics_t local;
+		for (int teamId = 1; teamId <= 30; ++teamId)
+		{
+			local.add_team(teamId);
+			local.add_player(teamId, teamId * 10);
+		}
+		local.remove_team(1);
+	}
+	
+	// Assert
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+
+#ifdef DS2_TEST_OLYMPICS_QUERY_CACHE
+// enable_query_cache(capacity) turns on an LRU cache of at most capacity query results.
+// get_cache_hits() / get_cache_misses() count the cached queries answered from / not from the cache.
+// Answers and side effects must always be the same as without the cache: a tournament answered from the cache
+// still adds its wins. A mutation only invalidates the cached ranges that contain the old or new strength of the
+// mutated team.
+
+// Gives every team one player whose strength is its id, so the teams with strength in [1, n] are exactly 1..n
+static void addPlayersByStrength(olympics_t& olympics, const std::vector<int>& teamIds)
+{
+	for (int teamId : teamIds)
+	{
+		olympics.add_player(teamId, teamId);
+	}
+}
+
+// Checks that two instances agree on every team's wins and on the highest ranked team
+static void expectSameRanking(olympics_t& cached, olympics_t& uncached, int maxTeamId)
+{
+	for (int teamId = 1; teamId <= maxTeamId; ++teamId)
+	{
+		auto res = cached.num_wins_for_team(teamId);
+		auto expected = uncached.num_wins_for_team(teamId);
+		ASSERT_EQ(res.status(), expected.status()) << "Wins of team " << teamId;
+		ASSERT_EQ(res.ans(), expected.ans()) << "Wins of team " << teamId;
+	}
+	auto res = cached.get_highest_ranked_team();
+	auto expected = uncached.get_highest_ranked_team();
+	ASSERT_EQ(res.status(), expected.status()) << "Highest ranked team";
+	ASSERT_EQ(res.ans(), expected.ans()) << "Highest ranked team";
+}
+
+// Test case to check that a cached instance answers like an uncached one under a random operation sequence
+TEST_F(InitializedOlympicsTeamsOnly, QueryCacheSameAnswers)
+{
+	// Arrange
+	olympics_t cached;
+	cached.enable_query_cache(64);
+	for (int teamId : existingIds)
+	{
+		cached.add_team(teamId);
+	}
+	const int maxTeamId = static_cast<int>(existingIds.size()) + 5;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, maxTeamId);
+	std::uniform_int_distribution<int> power(0, 300);
+	std::uniform_int_distribution<int> kind(0, 9);
+	
+	// Act & Assert
+	for (int i = 0; i < 5000; ++i)
+	{
+		int k = kind(gen);
+		if (k < 2)
+		{
+			int teamId = id(gen);
+			int strength = power(gen) + 1;
+			auto res = cached.add_player(teamId, strength);
+			auto expected = olympics.add_player(teamId, strength);
+			EXPECT_EQ(res, expected) << errMsg(ADD_PLAYER, std::make_pair(teamId, strength), expected, res);
+		}
+		else if (k < 3)
+		{
+			int teamId = id(gen);
+			auto res = cached.remove_newest_player(teamId);
+			auto expected = olympics.remove_newest_player(teamId);
+			EXPECT_EQ(res, expected) << errMsg(REMOVE_PLAYER, teamId, expected, res);
+		}
+		else if (k < 5)
+		{
+			int teamId1 = id(gen);
+			int teamId2 = id(gen);
+			auto res = cached.play_match(teamId1, teamId2);
+			auto expected = olympics.play_match(teamId1, teamId2);
+			EXPECT_EQ(res.status(), expected.status())
+								<< errMsg(PLAY_GAME, std::make_pair(teamId1, teamId2), expected.status(), res.status(),
+										  expected.ans(), res.ans());
+			if (expected.status() == SUCCESS)
+			{
+				EXPECT_EQ(res.ans(), expected.ans())
+									<< errMsg(PLAY_GAME, std::make_pair(teamId1, teamId2), expected.ans(), res.ans());
+			}
+		}
+		else
+		{
+			// Few distinct ranges so that queries repeat
+			int lowPower = power(gen) / 50 * 50;
+			int highPower = lowPower + 100;
+			auto res = cached.play_tournament(lowPower, highPower);
+			auto expected = olympics.play_tournament(lowPower, highPower);
+			EXPECT_EQ(res.status(), expected.status())
+								<< errMsg(PLAY_TOURNAMENT, std::make_pair(lowPower, highPower), expected.status(),
+										  res.status(), expected.ans(), res.ans());
+			if (expected.status() == SUCCESS)
+			{
+				EXPECT_EQ(res.ans(), expected.ans())
+									<< errMsg(PLAY_TOURNAMENT, std::make_pair(lowPower, highPower), expected.ans(),
+											  res.ans());
+			}
+		}
+		expectSameRanking(cached, olympics, maxTeamId);
+		ASSERT_FALSE(HasFatalFailure()) << "After operation #" << i;
+	}
+	EXPECT_GT(cached.get_cache_hits(), 0);
+	EXPECT_GT(cached.get_cache_misses(), 0);
+}
+
+// Test case to check that repeating a successful tournament is answered from the cache and still adds its wins
+TEST_F(InitializedOlympicsTeamsOnly, QueryCacheRepeatedQuery)
+{
+	// Arrange
+	olympics_t uncached;
+	for (int teamId : existingIds)
+	{
+		uncached.add_team(teamId);
+	}
+	addPlayersByStrength(uncached, existingIds);
+	olympics.enable_query_cache(16);
+	addPlayersByStrength(olympics, existingIds);
+	const int maxTeamId = static_cast<int>(existingIds.size());
+	
+	// Act
+	auto first = olympics.play_tournament(1, 16);
+	uncached.play_tournament(1, 16);
+	int missesAfterFirst = olympics.get_cache_misses();
+	std::vector<int> winsAfterFirst;
+	for (int teamId = 1; teamId <= maxTeamId; ++teamId)
+	{
+		winsAfterFirst.push_back(olympics.num_wins_for_team(teamId).ans());
+	}
+	auto second = olympics.play_tournament(1, 16);
+	uncached.play_tournament(1, 16);
+	
+	// Assert
+	ASSERT_EQ(first.status(), SUCCESS) << "16 teams are in range";
+	EXPECT_EQ(second.status(), first.status());
+	EXPECT_EQ(second.ans(), first.ans());
+	EXPECT_EQ(olympics.get_cache_misses(), missesAfterFirst);
+	EXPECT_EQ(olympics.get_cache_hits(), 1);
+	EXPECT_GT(olympics.num_wins_for_team(first.ans()).ans(), 0);
+	for (int teamId = 1; teamId <= maxTeamId; ++teamId)
+	{
+		EXPECT_EQ(olympics.num_wins_for_team(teamId).ans(), 2 * winsAfterFirst[teamId - 1])
+							<< "Team " << teamId << " did not get its wins from the cached tournament";
+	}
+	expectSameRanking(olympics, uncached, maxTeamId);
+}
+
+// Test case to check that a strength change of a team in the queried range is not answered from the cache
+TEST_F(InitializedOlympicsTeamsOnly, QueryCacheInvalidatedByMutation)
+{
+	// Arrange
+	olympics.enable_query_cache(16);
+	addPlayersByStrength(olympics, existingIds);
+	ASSERT_EQ(olympics.play_tournament(1, 16).status(), SUCCESS);
+	int hits = olympics.get_cache_hits();
+	
+	// Act
+	olympics.add_player(1, 1);
+	auto afterAdd = olympics.play_tournament(1, 16);
+	olympics.remove_team(16);
+	auto afterRemove = olympics.play_tournament(1, 16);
+	
+	// Assert
+	EXPECT_EQ(olympics.get_cache_hits(), hits);
+	EXPECT_EQ(afterAdd.status(), SUCCESS);
+	EXPECT_EQ(afterRemove.status(), FAILURE) << "15 teams are in range";
+}
+
+// Test case to check that mutations of teams outside the queried range keep the cached result
+TEST_F(InitializedOlympicsTeamsOnly, QueryCacheKeptByMutationOutsideRange)
+{
+	// Arrange
+	olympics_t uncached;
+	for (int teamId : existingIds)
+	{
+		uncached.add_team(teamId);
+	}
+	addPlayersByStrength(uncached, existingIds);
+	olympics.enable_query_cache(16);
+	addPlayersByStrength(olympics, existingIds);
+	auto first = olympics.play_tournament(1, 16);
+	uncached.play_tournament(1, 16);
+	int hits = olympics.get_cache_hits();
+	
+	// Act
+	for (olympics_t* instance : {&olympics, &uncached})
+	{
+		instance->add_player(30, 30);
+		instance->remove_newest_player(20);
+		instance->remove_team(29);
+		instance->add_team(100);
+		instance->play_match(17, 18);
+	}
+	auto second = olympics.play_tournament(1, 16);
+	uncached.play_tournament(1, 16);
+	
+	// Assert
+	ASSERT_EQ(first.status(), SUCCESS) << "16 teams are in range";
+	EXPECT_EQ(olympics.get_cache_hits(), hits + 1);
+	EXPECT_EQ(second.status(), first.status());
+	EXPECT_EQ(second.ans(), first.ans());
+	expectSameRanking(olympics, uncached, 100);
+}
+
+// Test case to check that the cache evicts the least recently used query once full
+TEST_F(InitializedOlympicsTeamsOnly, QueryCacheLruEviction)
+{
+	// Arrange
+	const int capacity = 4;
+	olympics.enable_query_cache(capacity);
+	addPlayersByStrength(olympics, existingIds);
+	
+	// Act
+	// Each range holds two teams, so every tournament succeeds
+	for (int i = 0; i <= capacity; ++i)
+	{
+		ASSERT_EQ(olympics.play_tournament(2 * i + 1, 2 * i + 2).status(), SUCCESS) << "Range #" << i;
+	}
+	int hits = olympics.get_cache_hits();
+	olympics.play_tournament(2 * capacity + 1, 2 * capacity + 2); // Most recent, still cached
+	olympics.play_tournament(1, 2); // Least recent, evicted
+	
+	// Assert
+	EXPECT_EQ(olympics.get_cache_hits(), hits + 1);
+	EXPECT_EQ(olympics.get_cache_misses(), capacity + 2);
+}
+#endif
+
+#ifdef DS2_TEST_OLYMPICS_TOP_K
+// top_k(k) returns a contiguous view (size() and operator[]) of the ids of the min(k, number of teams) strongest
+// teams, strongest first, in the same order as teamsByStrength from get_max() downwards. k up to 16 is supported.
+
+// Ids of the k strongest teams according to teamsByStrength
+static std::vector<int> strongestByTree(olympics_t& olympics, int k)
+{
+	auto byStrength = olympics.teamsByStrength.to_vec();
+	std::vector<int> ids;
+	for (auto it = byStrength.rbegin(); it != byStrength.rend() && static_cast<int>(ids.size()) < k; ++it)
+	{
+		ids.push_back(it->get_first().get_first());
+	}
+	return ids;
+}
+
+static void expectTopK(olympics_t& olympics, int k, const std::string& after)
+{
+	auto expected = strongestByTree(olympics, k);
+	auto top = olympics.top_k(k);
+	ASSERT_EQ(static_cast<size_t>(top.size()), expected.size()) << "top_k(" << k << ") after " << after;
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		EXPECT_EQ(top[i], expected[i]) << "top_k(" << k << ")[" << i << "] after " << after;
+	}
+}
+
+// Test case to check top_k on an empty Olympics instance and for k <= 0
+TEST_F(EmptyOlympics, TopKEmpty)
+{
+	EXPECT_EQ(olympics.top_k(5).size(), 0);
+	olympics.add_team(1);
+	EXPECT_EQ(olympics.top_k(0).size(), 0);
+	EXPECT_EQ(olympics.top_k(-3).size(), 0);
+	expectTopK(olympics, 5, "adding one team");
+}
+
+// Test case to cross-check top_k against teamsByStrength after every operation of a random sequence
+TEST_F(InitializedOlympicsTeamsOnly, TopKMatchesTree)
+{
+	// Arrange
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, static_cast<int>(existingIds.size()) + 10);
+	std::uniform_int_distribution<int> strength(1, 1000);
+	std::uniform_int_distribution<int> kind(0, 9);
+	
+	// Act & Assert
+	for (int i = 0; i < 3000; ++i)
+	{
+		int k = kind(gen);
+		int teamId = id(gen);
+		std::string after;
+		if (k < 1)
+		{
+			olympics.add_team(teamId);
+			after = opTypeToString(ADD_TEAM);
+		}
+		else if (k < 2)
+		{
+			olympics.remove_team(teamId);
+			after = opTypeToString(REMOVE_TEAM);
+		}
+		else if (k < 7)
+		{
+			olympics.add_player(teamId, strength(gen));
+			after = opTypeToString(ADD_PLAYER);
+		}
+		else
+		{
+			olympics.remove_newest_player(teamId);
+			after = opTypeToString(REMOVE_PLAYER);
+		}
+		after += " of " + std::to_string(teamId) + " (operation #" + std::to_string(i) + ")";
+		expectTopK(olympics, 1, after);
+		expectTopK(olympics, 10, after);
+		expectTopK(olympics, 16, after);
+		if (HasFailure())
+		{
+			return;
+		}
+	}
+}
+
+// Test case to check top_k after removing the strongest teams one by one
+TEST_F(InitializedOlympicsTeamsOnly, TopKRemoveStrongest)
+{
+	for (int teamId : existingIds)
+	{
+		olympics.add_player(teamId, teamId);
+	}
+	for (int i = 0; i < static_cast<int>(existingIds.size()); ++i)
+	{
+		auto top = olympics.top_k(1);
+		ASSERT_EQ(top.size(), 1);
+		int strongest = top[0];
+		expectTopK(olympics, 10, "removing " + std::to_string(i) + " strongest teams");
+		EXPECT_EQ(olympics.remove_team(strongest), SUCCESS);
+	}
+	EXPECT_EQ(olympics.top_k(10).size(), 0);
+}
+#endif
+
+#ifdef DS2_TEST_OLYMPICS_CHANGE_FEED
+// enable_change_feed(capacity) makes every successful add_team, remove_team, add_player, remove_newest_player and
+// play_match append a ChangeRecord {type, teamId, otherTeamId, oldStrength, newStrength} to a single-producer
+// single-consumer ring buffer of capacity records. drain_changes(out, maxRecords) moves up to maxRecords of the
+// oldest records into out and returns how many, and may run on another thread than the operations.
+// When the ring is full new records are dropped and counted by get_dropped_changes(), so a consumer that sees it
+// grow must rebuild its view from scratch. Failed operations and queries record nothing.
+// The strength fields hold the strength of teamId before and after the operation (0 after REMOVE_TEAM);
+// otherTeamId is only set for PLAY_MATCH.
+// play_tournament records nothing, even when it succeeds: there is no ChangeType for it, since it changes only wins
+// and never a strength or a team, so it cannot move anything in a view of teamsByStrength.
+
+static std::vector<ChangeRecord> drainAll(olympics_t& olympics)
+{
+	std::vector<ChangeRecord> records;
+	ChangeRecord batch[16];
+	int drained;
+	while ((drained = olympics.drain_changes(batch, 16)) > 0)
+	{
+		records.insert(records.end(), batch, batch + drained);
+	}
+	return records;
+}
+
+// Team id -> strength, as kept by teamsByStrength
+static std::map<int, int> strengthsByTree(olympics_t& olympics)
+{
+	std::map<int, int> strengths;
+	for (const auto& pair : olympics.teamsByStrength.to_vec())
+	{
+		strengths[pair.get_first().get_first()] = pair.get_first().get_second();
+	}
+	return strengths;
+}
+
+// Test case to check that nothing is recorded or dropped while the feed is disabled
+TEST_F(InitializedOlympicsTeamsOnly, ChangeFeedDisabled)
+{
+	for (int teamId : existingIds)
+	{
+		olympics.add_player(teamId, teamId);
+	}
+	olympics.remove_team(existingIds.front());
+	ChangeRecord batch[16];
+	EXPECT_EQ(olympics.drain_changes(batch, 16), 0);
+	EXPECT_EQ(olympics.get_dropped_changes(), 0);
+}
+
+// Test case to check that exactly the successful mutations are recorded, in order, with their ids
+TEST_F(InitializedOlympicsTeamsOnly, ChangeFeedRecordsSuccessfulOperations)
+{
+	// Arrange
+	EXPECT_EQ(olympics.enable_change_feed(1024), SUCCESS);
+	std::vector<ChangeType> expectedTypes;
+	std::vector<std::pair<int, int>> expectedIds;
+	auto expectRecord = [&](StatusType res, ChangeType type, int teamId, int otherTeamId)
+	{
+		if (res == SUCCESS)
+		{
+			expectedTypes.push_back(type);
+			expectedIds.emplace_back(teamId, otherTeamId);
+		}
+	};
+	
+	// Act
+	expectRecord(olympics.add_team(100), ChangeType::ADD_TEAM, 100, 0);
+	expectRecord(olympics.add_team(100), ChangeType::ADD_TEAM, 100, 0);
+	expectRecord(olympics.add_player(1, 5), ChangeType::ADD_PLAYER, 1, 0);
+	expectRecord(olympics.add_player(2, 7), ChangeType::ADD_PLAYER, 2, 0);
+	expectRecord(olympics.add_player(999, 5), ChangeType::ADD_PLAYER, 999, 0);
+	expectRecord(olympics.add_player(1, -5), ChangeType::ADD_PLAYER, 1, 0);
+	expectRecord(olympics.play_match(1, 2).status(), ChangeType::PLAY_MATCH, 1, 2);
+	expectRecord(olympics.play_match(1, 999).status(), ChangeType::PLAY_MATCH, 1, 999);
+	// Only teams 1 and 2 have strength in [1, 100], so the tournament is valid and team 2 wins it
+	auto tournament = olympics.play_tournament(1, 100);
+	ASSERT_EQ(tournament.status(), SUCCESS);
+	EXPECT_EQ(tournament.ans(), 2);
+	expectRecord(olympics.remove_newest_player(1), ChangeType::REMOVE_PLAYER, 1, 0);
+	expectRecord(olympics.remove_newest_player(100), ChangeType::REMOVE_PLAYER, 100, 0);
+	expectRecord(olympics.remove_team(100), ChangeType::REMOVE_TEAM, 100, 0);
+	expectRecord(olympics.remove_team(100), ChangeType::REMOVE_TEAM, 100, 0);
+	auto records = drainAll(olympics);
+	
+	// Assert
+	ASSERT_EQ(records.size(), expectedTypes.size()) << "play_tournament must not be recorded";
+	for (size_t i = 0; i < records.size(); ++i)
+	{
+		EXPECT_TRUE(records[i].type == expectedTypes[i]) << "record #" << i << " has the wrong type";
+		EXPECT_EQ(records[i].teamId, expectedIds[i].first) << "record #" << i;
+		EXPECT_EQ(records[i].otherTeamId, expectedIds[i].second) << "record #" << i;
+	}
+	EXPECT_EQ(olympics.get_dropped_changes(), 0);
+	ChangeRecord batch[1];
+	EXPECT_EQ(olympics.drain_changes(batch, 1), 0);
+}
+
+// Test case to check that a view built only from the feed, drained in small batches, matches teamsByStrength.
+// Assumes the teamsByStrength key is a Pair of team id and strength.
+TEST_F(InitializedOlympicsTeamsOnly, ChangeFeedReplayMatchesTree)
+{
+	// Arrange
+	std::map<int, int> view = strengthsByTree(olympics);
+	EXPECT_EQ(olympics.enable_change_feed(64), SUCCESS);
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> id(1, static_cast<int>(existingIds.size()) + 10);
+	std::uniform_int_distribution<int> strength(1, 1000);
+	std::uniform_int_distribution<int> kind(0, 9);
+	ChangeRecord batch[7];
+	
+	// Act & Assert
+	for (int i = 0; i < 3000; ++i)
+	{
+		int k = kind(gen);
+		int teamId = id(gen);
+		if (k < 1)
+		{
+			olympics.add_team(teamId);
+		}
+		else if (k < 2)
+		{
+			olympics.remove_team(teamId);
+		}
+		else if (k < 6)
+		{
+			olympics.add_player(teamId, strength(gen));
+		}
+		else if (k < 8)
+		{
+			olympics.remove_newest_player(teamId);
+		}
+		else
+		{
+			olympics.play_match(teamId, id(gen));
+		}
+		
+		if (i % 10 == 9)
+		{
+			int drained;
+			while ((drained = olympics.drain_changes(batch, 7)) > 0)
+			{
+				for (int j = 0; j < drained; ++j)
+				{
+					const ChangeRecord& record = batch[j];
+					if (record.type != ChangeType::ADD_TEAM)
+					{
+						ASSERT_EQ(view.count(record.teamId), 1) << "record for unknown team " << record.teamId;
+						EXPECT_EQ(view[record.teamId], record.oldStrength)
+											<< "old strength of team " << record.teamId << " (operation #" << i << ")";
+					}
+					if (record.type == ChangeType::REMOVE_TEAM)
+					{
+						view.erase(record.teamId);
+					}
+					else
+					{
+						view[record.teamId] = record.newStrength;
+					}
+				}
+			}
+			ASSERT_EQ(olympics.get_dropped_changes(), 0);
+			ASSERT_TRUE(view == strengthsByTree(olympics)) << "view differs from teamsByStrength after operation #"
+																<< i;
+		}
+	}
+}
+
+// Test case to check that records beyond the capacity are dropped and counted, and the feed recovers after a drain
+TEST_F(EmptyOlympics, ChangeFeedOverflow)
+{
+	// Arrange
+	const int capacity = 8;
+	EXPECT_EQ(olympics.enable_change_feed(capacity), SUCCESS);
+	
+	// Act
+	for (int teamId = 1; teamId <= 20; ++teamId)
+	{
+		olympics.add_team(teamId);
+	}
+	auto records = drainAll(olympics);
+	
+	// Assert
+	ASSERT_EQ(static_cast<int>(records.size()), capacity);
+	for (int i = 0; i < capacity; ++i)
+	{
+		EXPECT_EQ(records[i].teamId, i + 1) << "the oldest records must be kept";
+	}
+	EXPECT_EQ(olympics.get_dropped_changes(), 20 - capacity);
+	
+	olympics.add_team(21);
+	records = drainAll(olympics);
+	ASSERT_EQ(static_cast<int>(records.size()), 1);
+	EXPECT_EQ(records[0].teamId, 21);
+	EXPECT_EQ(olympics.get_dropped_changes(), 20 - capacity);
+}
+
+// Test case to check draining on another thread while the operations run
+TEST_F(EmptyOlympics, ChangeFeedConcurrentConsumer)
+{
+	// Arrange
+	const int numTeams = 100000;
+	EXPECT_EQ(olympics.enable_change_feed(256), SUCCESS);
+	std::atomic<bool> done(false);
+	long long consumed = 0;
+	int lastTeamId = 0;
+	bool ordered = true;
+	std::thread consumer([&]
+						 {
+							 ChangeRecord batch[32];
+							 while (true)
+							 {
+								 bool finished = done.load();
+								 int drained = olympics.drain_changes(batch, 32);
+								 for (int i = 0; i < drained; ++i)
+								 {
+									 ordered = ordered && batch[i].teamId > lastTeamId;
+									 lastTeamId = batch[i].teamId;
+								 }
+								 consumed += drained;
+								 if (finished && drained == 0)
+								 {
+									 return;
+								 }
+								 if (drained == 0)
+								 {
+									 std::this_thread::yield();
+								 }
+							 }
+						 });
+	
+	// Act
+	for (int teamId = 1; teamId <= numTeams; ++teamId)
+	{
+		olympics.add_team(teamId);
+	}
+	done.store(true);
+	consumer.join();
+	
+	// Assert
+	EXPECT_TRUE(ordered) << "records were drained out of order";
+	EXPECT_EQ(consumed + olympics.get_dropped_changes(), numTeams);
+	EXPECT_GT(consumed, 0);
+}
+
+// Test case to check that an undrained feed does not grow past its capacity
+TEST_F(InitializedOlympicsTeamsOnly, ChangeFeedBoundedMemory)
+{
+	// Arrange: fill the feed with add/remove player pairs, which leave the teams unchanged
+	const int capacity = 1024;
+	EXPECT_EQ(olympics.enable_change_feed(capacity), SUCCESS);
+	auto addAndRemove = [&](int i)
+	{
+		int teamId = existingIds[i % existingIds.size()];
+		EXPECT_EQ(olympics.add_player(teamId, i + 1), SUCCESS);
+		EXPECT_EQ(olympics.remove_newest_player(teamId), SUCCESS);
+	};
+	for (int i = 0; i < capacity; ++i)
+	{
+		addAndRemove(i);
+	}
+	
+	// Act
+	AllocationScope scope;
+	for (int i = capacity; i < 50000; ++i)
+	{
+		addAndRemove(i);
+	}
+	
+	// Assert
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(olympics.get_dropped_changes(), 2 * 50000 - capacity);
+}
+
+// Test case to check that the capacity must be positive
+TEST_F(EmptyOlympics, ChangeFeedInvalidCapacity)
+{
+	EXPECT_EQ(olympics.enable_change_feed(0), INVALID_INPUT);
+	EXPECT_EQ(olympics.enable_change_feed(-1), INVALID_INPUT);
+	olympics.add_team(1);
+	ChangeRecord batch[1];
+	EXPECT_EQ(olympics.drain_changes(batch, 1), 0);
+}
+#endif
+
+#ifdef DS2_TEST_TEAM_SIMD_STRENGTH
+// play_matches(teamIds1, teamIds2, n, out) evaluates n matches at once. out holds n constructed output_t<int>, and
+// each is destroyed and placement-constructed with its answer, since output_t is not assignable. Results and
+// side effects (wins) must be the same as n calls to play_match in order, including invalid and repeated pairs.
+
+// Test case to check batched matches against single play_match calls on teams of very different sizes
+TEST_F(InitializedOlympicsTeamsOnly, PlayMatchesSameAnswers)
+{
+	// Arrange
+	olympics_t single;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> strength(1, 1000);
+	for (int teamId : existingIds)
+	{
+		single.add_team(teamId);
+		// From empty teams up to a few thousand players
+		int numPlayers = teamId % 5 == 0 ? 0 : teamId * teamId * 3;
+		for (int i = 0; i < numPlayers; ++i)
+		{
+			int s = strength(gen);
+			olympics.add_player(teamId, s);
+			single.add_player(teamId, s);
+		}
+	}
+	const int n = 500;
+	std::uniform_int_distribution<int> id(-1, static_cast<int>(existingIds.size()) + 2);
+	std::vector<int> teamIds1(n);
+	std::vector<int> teamIds2(n);
+	for (int i = 0; i < n; ++i)
+	{
+		teamIds1[i] = id(gen);
+		teamIds2[i] = id(gen);
+	}
+	
+	// Act
+	std::vector<output_t<int>> results(n);
+	olympics.play_matches(teamIds1.data(), teamIds2.data(), n, results.data());
+	
+	// Assert
+	for (int i = 0; i < n; ++i)
+	{
+		auto expected = single.play_match(teamIds1[i], teamIds2[i]);
+		EXPECT_EQ(results[i].status(), expected.status())
+							<< errMsg(PLAY_GAME, std::make_pair(teamIds1[i], teamIds2[i]), expected.status(),
+									  results[i].status(), expected.ans(), results[i].ans());
+		if (expected.status() == SUCCESS)
+		{
+			EXPECT_EQ(results[i].ans(), expected.ans())
+								<< errMsg(PLAY_GAME, std::make_pair(teamIds1[i], teamIds2[i]), expected.ans(),
+										  results[i].ans());
+		}
+	}
+	for (int teamId : existingIds)
+	{
+		EXPECT_EQ(olympics.num_wins_for_team(teamId).ans(), single.num_wins_for_team(teamId).ans())
+							<< "wins of team " << teamId;
+	}
+}
+
+// Test case to check that a batch sees the strength changes made before it, and an empty batch does nothing
+TEST_F(InitializedOlympicsTeamsOnly, PlayMatchesAfterStrengthChanges)
+{
+	olympics_t single;
+	for (int teamId : existingIds)
+	{
+		single.add_team(teamId);
+	}
+	auto expectSameWins = [&](const char* step)
+	{
+		for (int teamId : existingIds)
+		{
+			EXPECT_EQ(olympics.num_wins_for_team(teamId).ans(), single.num_wins_for_team(teamId).ans())
+								<< "wins of team " << teamId << " " << step;
+		}
+	};
+	auto playBoth = [&](int* teamIds1, int* teamIds2, int n)
+	{
+		std::vector<output_t<int>> results(n);
+		olympics.play_matches(teamIds1, teamIds2, n, results.data());
+		for (int i = 0; i < n; ++i)
+		{
+			auto expected = single.play_match(teamIds1[i], teamIds2[i]);
+			EXPECT_EQ(results[i].status(), expected.status())
+								<< errMsg(PLAY_GAME, std::make_pair(teamIds1[i], teamIds2[i]), expected.status(),
+										  results[i].status(), expected.ans(), results[i].ans());
+			if (expected.status() == SUCCESS)
+			{
+				EXPECT_EQ(results[i].ans(), expected.ans());
+			}
+		}
+	};
+	
+	olympics.play_matches(nullptr, nullptr, 0, nullptr);
+	expectSameWins("after the empty batch");
+	for (int teamId : existingIds)
+	{
+		olympics.add_player(teamId, teamId);
+		single.add_player(teamId, teamId);
+	}
+	int teamIds1[] = {1, 2, 3};
+	int teamIds2[] = {30, 29, 28};
+	playBoth(teamIds1, teamIds2, 3);
+	expectSameWins("after the first batch");
+	
+	for (int i = 0; i < 100; ++i)
+	{
+		olympics.add_player(1, 1000);
+		single.add_player(1, 1000);
+	}
+	olympics.remove_newest_player(30);
+	single.remove_newest_player(30);
+	playBoth(teamIds1, teamIds2, 3);
+	expectSameWins("after the second batch");
+}
+#endif
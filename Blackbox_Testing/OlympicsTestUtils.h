@@ -7,6 +7,7 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 #include "../utils.h"
 
 // Enum for operation types
@@ -37,74 +38,51 @@ std::string opTypeToString(OpType op)
 	}
 }
 
+// Stream operator for pair operands, e.g. (teamId, playerStrength)
 template <class T, class S>
-std::string& operator+(std::string& str, const std::pair<T, S>& p);
-
-// string operator += with pair<T, S>
-template <class T, class S>
-std::string& operator+=(std::string& str, std::pair<T, S> p)
+std::ostream& operator<<(std::ostream& os, const std::pair<T, S>& p)
 {
-	str += std::to_string(p.first) + ", " + std::to_string(p.second);
-	return str;
+	return os << p.first << ", " << p.second;
 }
 
-template <typename S>
-std::string errMsg(OpType op, S operand, StatusType expected, StatusType actual);
-
-// Function to generate error message for operations with expected and actual statuses and values
-template <typename T, typename S>
-std::string errMsg(OpType op, S operand, StatusType expected, StatusType actual, T valExp, T valActual);
-
-// Function to generate error message for operations with only expected and actual values
-template <typename T, typename S>
-std::string errMsg(OpType op, S operand, T valExp, T valActual);
+// The messages below are only built when an assertion fails: gtest evaluates the expression streamed into
+// EXPECT_* / ASSERT_* only on failure, so passing checks never pay for the formatting.
 
 // Function to generate error message for operations with expected and actual statuses
 template <typename S>
 std::string errMsg(OpType op, S operand, StatusType expected, StatusType actual)
 {
-	std::string string;
-	string += opTypeToString(op) +  " of ";
-	string += operand;
-	string += " failed.\n";
+	std::ostringstream msg;
+	msg << opTypeToString(op) << " of " << operand << " failed.\n";
 	if (expected != actual)
 	{
-		string + "Expected result " + str(expected) + ", Actual: " + str(actual) + "\n";
+		msg << "Expected result " << status_type_strings[static_cast<int>(expected)] << ", Actual: "
+			<< status_type_strings[static_cast<int>(actual)] << "\n";
 	}
-	return string;
+	return msg.str();
 }
 
 // Function to generate error message for operations with expected and actual statuses and values
 template <typename T, typename S>
 std::string errMsg(OpType op, S operand, StatusType expected, StatusType actual, T valExp, T valActual)
 {
-	std::string str;
-	str += errMsg(op, operand, expected, actual);
+	std::ostringstream msg;
+	msg << errMsg(op, operand, expected, actual);
 	if (valExp != valActual)
 	{
-		str += "Expected value: " + valExp + ", Actual: " + valActual + "\n";
+		msg << "Expected value: " << valExp << ", Actual: " << valActual << "\n";
 	}
-	return str;
+	return msg.str();
 }
 
 // Function to generate error message for operations with only expected and actual values
 template <typename T, typename S>
 std::string errMsg(OpType op, S operand, T valExp, T valActual)
 {
-	std::string str;
-	str += opTypeToString(op) + " of " + operand + " failed.\n";
-	str += "Expected value: " + valExp + ", Actual: " + valActual + "\n";
-	return str;
+	std::ostringstream msg;
+	msg << opTypeToString(op) << " of " << operand << " failed.\n";
+	msg << "Expected value: " << valExp << ", Actual: " << valActual << "\n";
+	return msg.str();
 }
 
-//template <class T, class S>
-//std::string& operator+=(std::string& str, const std::pair<T, S>& p)
-//{
-//	str += p.first + ", " + p.second;
-//	return str;
-//}
-
-
-
-
 #endif //DATASTRUCTURES2_OLYMPICSTESTUTILS_H
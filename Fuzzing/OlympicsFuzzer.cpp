@@ -0,0 +1,355 @@
+//
+// Fuzz target for olympics_t.
+// Decodes the input bytes into a sequence of OpType operations, runs them against a fresh olympics_t
+// and checks every returned status against a shadow model of the teams (ids, player counts and the strength
+// each team had after each of its players was added). After every operation it also checks that
+// teamsHashTable, teamsById and teamsByStrength agree with each other and with the model, down to the
+// {id, strength} key of every teamsByStrength entry.
+// Any operation that takes longer than the time budget is reported the same way as a crash, so that
+// performance cliffs leave a reproducing input behind.
+//
+// Built with libFuzzer when the compiler supports it (clang), otherwise with a standalone main that reads
+// the inputs from the files given on the command line, or from stdin (AFL++ style).
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../olympics24a2.h"
+#include "../Blackbox_Testing/OlympicsTestUtils.h"
+
+// Maximum number of operations decoded from a single input
+#define MAX_OPS 4096
+
+// Default time budget for a single operation, in microseconds (override with DS2_FUZZ_OP_BUDGET_US)
+#define DEFAULT_OP_BUDGET_US 20000
+
+// Reads operands from the fuzzer input, returning zeros once the input is exhausted
+class ByteReader
+{
+public:
+	ByteReader(const uint8_t* data, size_t size) : data(data), size(size), pos(0)
+	{}
+
+	bool empty() const
+	{
+		return pos >= size;
+	}
+
+	uint8_t nextByte()
+	{
+		return pos < size ? data[pos++] : 0;
+	}
+
+	// Mostly small ids (including zero and negative ones) so operations hit existing teams,
+	// with an occasional full 32-bit value
+	int nextInt()
+	{
+		uint8_t selector = nextByte();
+		if (selector & 0x80)
+		{
+			uint32_t value = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				value = (value << 8) | nextByte();
+			}
+			return static_cast<int>(value);
+		}
+		return static_cast<int>(selector) - 8;
+	}
+
+private:
+	const uint8_t* data;
+	size_t size;
+	size_t pos;
+};
+
+static long long opBudgetUs()
+{
+	static const long long budget = []
+	{
+		const char* env = std::getenv("DS2_FUZZ_OP_BUDGET_US");
+		return env ? std::atoll(env) : DEFAULT_OP_BUDGET_US;
+	}();
+	return budget;
+}
+
+static void fail(int opIndex, OpType op, const std::string& operand, const std::string& reason)
+{
+	std::fprintf(stderr, "Operation #%d (%s of %s): %s\n", opIndex, opTypeToString(op).c_str(), operand.c_str(),
+				 reason.c_str());
+	std::abort();
+}
+
+static void expectStatus(int opIndex, OpType op, const std::string& operand, StatusType expected, StatusType actual)
+{
+	if (expected != actual)
+	{
+		fail(opIndex, op, operand, "Expected result " + str(expected) + ", Actual: " + str(actual));
+	}
+}
+
+// Shadow model of a team. strengths[k] is the strength the team had with its first k players, so removing the
+// newest player must bring the team back to the previous entry.
+struct TeamModel
+{
+	int players = 0;
+	std::vector<int> strengths;
+};
+
+static bool isPowerOfTwo(int n)
+{
+	return n > 0 && (n & (n - 1)) == 0;
+}
+
+// Number of teams whose strength is in [lowPower, highPower], i.e. the teams play_tournament would seat
+static int teamsInRange(const std::map<int, TeamModel>& teams, int lowPower, int highPower)
+{
+	int count = 0;
+	for (const auto& team : teams)
+	{
+		int strength = team.second.strengths.back();
+		if (strength >= lowPower && strength <= highPower)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+// Checks that all three team containers agree with each other and with the shadow model.
+// changedTeam is the team whose new strength the operation just produced: its teamsByStrength key is recorded
+// in the model instead of being checked against it.
+static void checkConsistency(int opIndex, OpType op, const std::string& operand, olympics_t& olympics,
+							 std::map<int, TeamModel>& teams, int changedTeam)
+{
+	const int expectedSize = static_cast<int>(teams.size());
+	if (olympics.teamsHashTable.get_size() != expectedSize)
+	{
+		fail(opIndex, op, operand, "teamsHashTable has " + std::to_string(olympics.teamsHashTable.get_size()) +
+								   " teams, expected " + std::to_string(expectedSize));
+	}
+	if (olympics.teamsById.get_size() != expectedSize)
+	{
+		fail(opIndex, op, operand, "teamsById has " + std::to_string(olympics.teamsById.get_size()) +
+								   " teams, expected " + std::to_string(expectedSize));
+	}
+	if (olympics.teamsByStrength.get_size() != expectedSize)
+	{
+		fail(opIndex, op, operand, "teamsByStrength has " + std::to_string(olympics.teamsByStrength.get_size()) +
+								   " teams, expected " + std::to_string(expectedSize));
+	}
+	if (!olympics.teamsById.is_valid())
+	{
+		fail(opIndex, op, operand, "teamsById is not a valid AVL tree");
+	}
+	if (!olympics.teamsByStrength.is_valid())
+	{
+		fail(opIndex, op, operand, "teamsByStrength is not a valid AVL tree");
+	}
+
+	auto byId = olympics.teamsById.to_vec();
+	auto expectedId = teams.begin();
+	for (const auto& pair : byId)
+	{
+		if (expectedId == teams.end() || pair.get_first() != expectedId->first)
+		{
+			fail(opIndex, op, operand, "teamsById is out of order or holds unexpected team " +
+									   std::to_string(pair.get_first()));
+		}
+		if (olympics.teamsHashTable.find(pair.get_first()).status() != SUCCESS)
+		{
+			fail(opIndex, op, operand, "team " + std::to_string(pair.get_first()) + " missing from teamsHashTable");
+		}
+		++expectedId;
+	}
+
+	// Every {id, strength} key must name a live team at its current strength, and point at the same team object
+	// as the other two containers
+	auto byStrength = olympics.teamsByStrength.to_vec();
+	std::set<int> seen;
+	for (const auto& pair : byStrength)
+	{
+		int teamId = pair.get_first().get_first();
+		int strength = pair.get_first().get_second();
+		auto team = teams.find(teamId);
+		if (team == teams.end() || !seen.insert(teamId).second)
+		{
+			fail(opIndex, op, operand, "teamsByStrength holds unexpected or duplicate team " + std::to_string(teamId));
+		}
+		if (teamId == changedTeam)
+		{
+			team->second.strengths.push_back(strength);
+		}
+		else if (strength != team->second.strengths.back())
+		{
+			fail(opIndex, op, operand, "teamsByStrength holds team " + std::to_string(teamId) + " at strength " +
+									   std::to_string(strength) + ", expected " +
+									   std::to_string(team->second.strengths.back()));
+		}
+		if (olympics.teamsById.find(teamId).ans() != pair.get_second())
+		{
+			fail(opIndex, op, operand, "teamsByStrength and teamsById disagree on team " + std::to_string(teamId));
+		}
+		if (olympics.teamsHashTable.find(teamId).ans() != pair.get_second())
+		{
+			fail(opIndex, op, operand, "teamsByStrength and teamsHashTable disagree on team " +
+									   std::to_string(teamId));
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	ByteReader reader(data, size);
+	olympics_t olympics;
+	std::map<int, TeamModel> teams;
+
+	for (int i = 0; i < MAX_OPS && !reader.empty(); ++i)
+	{
+		OpType op = static_cast<OpType>(reader.nextByte() % (PLAY_TOURNAMENT + 1));
+		int first = reader.nextInt();
+		int second = 0;
+		std::string operand = std::to_string(first);
+
+		StatusType res;
+		auto start = std::chrono::steady_clock::now();
+		switch (op)
+		{
+			case ADD_TEAM:
+				res = olympics.add_team(first);
+				break;
+			case REMOVE_TEAM:
+				res = olympics.remove_team(first);
+				break;
+			case ADD_PLAYER:
+				second = reader.nextInt();
+				res = olympics.add_player(first, second);
+				break;
+			case REMOVE_PLAYER:
+				res = olympics.remove_newest_player(first);
+				break;
+			case PLAY_GAME:
+				second = reader.nextInt();
+				res = olympics.play_match(first, second).status();
+				break;
+			case PLAY_TOURNAMENT:
+				second = reader.nextInt();
+				res = olympics.play_tournament(first, second).status();
+				break;
+			default:
+				continue;
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start).count();
+		if (op == ADD_PLAYER || op == PLAY_GAME || op == PLAY_TOURNAMENT)
+		{
+			operand += ", " + std::to_string(second);
+		}
+
+		if (elapsed > opBudgetUs())
+		{
+			fail(i, op, operand, "took " + std::to_string(elapsed) + "us, budget is " +
+								 std::to_string(opBudgetUs()) + "us");
+		}
+
+		auto team = teams.find(first);
+		bool exists = team != teams.end();
+		int changedTeam = 0;
+		switch (op)
+		{
+			case ADD_TEAM:
+				expectStatus(i, op, operand, first <= 0 ? INVALID_INPUT : exists ? FAILURE : SUCCESS, res);
+				if (res == SUCCESS)
+				{
+					teams[first];
+					changedTeam = first;
+				}
+				break;
+			case REMOVE_TEAM:
+				expectStatus(i, op, operand, first <= 0 ? INVALID_INPUT : exists ? SUCCESS : FAILURE, res);
+				if (res == SUCCESS)
+				{
+					teams.erase(team);
+				}
+				break;
+			case ADD_PLAYER:
+				expectStatus(i, op, operand, first <= 0 || second <= 0 ? INVALID_INPUT : exists ? SUCCESS : FAILURE,
+							 res);
+				if (res == SUCCESS)
+				{
+					++team->second.players;
+					changedTeam = first;
+				}
+				break;
+			case REMOVE_PLAYER:
+				expectStatus(i, op, operand,
+							 first <= 0 ? INVALID_INPUT : exists && team->second.players > 0 ? SUCCESS : FAILURE, res);
+				if (res == SUCCESS)
+				{
+					--team->second.players;
+					team->second.strengths.pop_back();
+				}
+				break;
+			case PLAY_GAME:
+			{
+				auto other = teams.find(second);
+				bool playable = exists && other != teams.end() && team->second.players > 0 &&
+								other->second.players > 0;
+				expectStatus(i, op, operand, first <= 0 || second <= 0 || first == second ? INVALID_INPUT :
+											 playable ? SUCCESS : FAILURE, res);
+				break;
+			}
+			case PLAY_TOURNAMENT:
+				expectStatus(i, op, operand, first <= 0 || second <= 0 || second <= first ? INVALID_INPUT :
+											 isPowerOfTwo(teamsInRange(teams, first, second)) ? SUCCESS : FAILURE,
+							 res);
+				break;
+			default:
+				break;
+		}
+
+		checkConsistency(i, op, operand, olympics, teams, changedTeam);
+	}
+	return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+static void runInput(std::FILE* file)
+{
+	std::vector<uint8_t> input;
+	uint8_t buffer[4096];
+	size_t read;
+	while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+	{
+		input.insert(input.end(), buffer, buffer + read);
+	}
+	LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		runInput(stdin);
+		return 0;
+	}
+	for (int i = 1; i < argc; ++i)
+	{
+		std::FILE* file = std::fopen(argv[i], "rb");
+		if (!file)
+		{
+			std::fprintf(stderr, "Cannot open %s\n", argv[i]);
+			return 1;
+		}
+		runInput(file);
+		std::fclose(file);
+	}
+	return 0;
+}
+#endif
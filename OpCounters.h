@@ -0,0 +1,44 @@
+//
+// Operation counters for the complexity tests (Whitebox_Testing/ComplexityTest.cpp).
+// The tested AVL_Tree and HashTable call DS2_COUNT(counter) at the counted points. It compiles to nothing unless
+// OP_COUNTERS is listed in DS2_FEATURES, so the counters cost nothing in normal builds.
+//
+
+#ifndef DATASTRUCTURES2_OPCOUNTERS_H
+#define DATASTRUCTURES2_OPCOUNTERS_H
+
+struct OpCounters
+{
+	unsigned long long comparisons = 0;  // AVL_Tree: key comparisons
+	unsigned long long nodesVisited = 0; // AVL_Tree: nodes entered while walking the tree
+	unsigned long long rotations = 0;    // AVL_Tree: single rotations (a double rotation counts as 2)
+	unsigned long long probes = 0;       // HashTable: entries examined while looking for a key
+	                                     // CuckooHashTable: buckets examined (the stash is not a bucket)
+	unsigned long long rehashes = 0;     // HashTable: resizes of the bucket array
+	
+	OpCounters operator-(const OpCounters& other) const
+	{
+		OpCounters diff;
+		diff.comparisons = comparisons - other.comparisons;
+		diff.nodesVisited = nodesVisited - other.nodesVisited;
+		diff.rotations = rotations - other.rotations;
+		diff.probes = probes - other.probes;
+		diff.rehashes = rehashes - other.rehashes;
+		return diff;
+	}
+};
+
+// The counters shared by all structures
+inline OpCounters& opCounters()
+{
+	static OpCounters counters;
+	return counters;
+}
+
+#ifdef DS2_TEST_OP_COUNTERS
+#define DS2_COUNT(counter) (++opCounters().counter)
+#else
+#define DS2_COUNT(counter) ((void) 0)
+#endif
+
+#endif //DATASTRUCTURES2_OPCOUNTERS_H
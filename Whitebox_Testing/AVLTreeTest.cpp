@@ -5,6 +5,16 @@
 #include "../../wet2util.h"
 #include "../lib/googletest/include/gtest/gtest.h"
 #include "../../AVL_Tree.h"
+#include "../AllocationTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
 
 #define SUCCESS StatusType::SUCCESS
 #define FAILURE StatusType::FAILURE
@@ -183,15 +193,15 @@ TEST_F(AVLTreeFixture, Remove)
 }
 TEST_F(AVLTreeFixture, ConstructFromSortedArray)
 {
-	int* values = new int[vec.size()];
-	int* keys = new int[vec.size()];
+	std::vector<int> values(vec.size());
+	std::vector<int> keys(vec.size());
 	for (int i = 0; i < vec.size(); ++i)
 	{
 		keys[i] = vec[i].get_first();
 		values[i] = vec[i].get_second();
 	}
 	
-	auto tree = AVL_Tree<int, int>(values, keys, vec.size());
+	auto tree = AVL_Tree<int, int>(values.data(), keys.data(), vec.size());
 	ASSERT_TRUE(tree.is_valid());
 	EXPECT_EQ(tree.to_vec(), vec);
 	std::stringstream ss;
@@ -224,14 +234,14 @@ TEST(SUITE, ConstructFromEmptyArray)
 
 TEST_F(AVLTreeFixture, checkExtra)
 {
-	int* values = new int[vec.size()];
-	int* keys = new int[vec.size()];
+	std::vector<int> values(vec.size());
+	std::vector<int> keys(vec.size());
 	for (int i = 0; i < vec.size(); ++i)
 	{
 		keys[i] = vec[i].get_first();
 		values[i] = vec[i].get_second();
 	}
-	auto tree = AVL_Tree<int, int>(values, keys, vec.size());
+	auto tree = AVL_Tree<int, int>(values.data(), keys.data(), vec.size());
 	ASSERT_TRUE(tree.is_valid());
 	tree.add_extra(8, 4);
 	for(auto pair : vec)
@@ -271,14 +281,14 @@ TEST_F(AVLTreeFixture, checkExtra)
 TEST_F(AVLTreeFixture, checkExtraWithRotates)
 {
 	auto copyVec = std::vector<Pair<int, int>>(vec);
-	int* values = new int[copyVec.size()];
-	int* keys = new int[copyVec.size()];
+	std::vector<int> values(copyVec.size());
+	std::vector<int> keys(copyVec.size());
 	for (int i = 0; i < copyVec.size(); ++i)
 	{
 		keys[i] = copyVec[i].get_first();
 		values[i] = copyVec[i].get_second();
 	}
-	auto tree = AVL_Tree<int, int>(values, keys, copyVec.size());
+	auto tree = AVL_Tree<int, int>(values.data(), keys.data(), copyVec.size());
 	ASSERT_TRUE(tree.is_valid());
 	tree.add_extra(8, 4);
 	tree.add_extra(4, -3);
@@ -328,3 +338,949 @@ TEST_F(AVLTreeFixture, checkExtraWithRotates)
 	}
 }
 
+TEST(SUITE, NoLeaks)
+{
+	AllocationScope scope;
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		for (int i = 0; i < 1000; ++i)
+		{
+			EXPECT_EQ(tree.insert(i, i), SUCCESS);
+		}
+		for (int i = 0; i < 1000; i += 2)
+		{
+			EXPECT_EQ(tree.remove(i), SUCCESS);
+		}
+		ASSERT_TRUE(tree.is_valid());
+		EXPECT_GT(scope.liveBytes(), 0);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+
+TEST_F(AVLTreeFixture, ConstructFromSortedArrayNoLeaks)
+{
+	AllocationScope scope;
+	{
+		std::vector<int> values(vec.size());
+		std::vector<int> keys(vec.size());
+		for (int i = 0; i < vec.size(); ++i)
+		{
+			keys[i] = vec[i].get_first();
+			values[i] = vec[i].get_second();
+		}
+		auto tree = AVL_Tree<int, int>(values.data(), keys.data(), vec.size());
+		ASSERT_TRUE(tree.is_valid());
+		tree.add_extra(8, 4);
+		EXPECT_EQ(tree.remove(vec[0].get_first()), SUCCESS);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+
+#ifdef DS2_TEST_AVL_SNAPSHOT
+// snapshot() returns an immutable version of the tree that shares structure with it.
+// Writes to the tree after the snapshot was taken must not be visible through the snapshot.
+
+TEST(SUITE, SnapshotEmptyTree)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	auto snapshot = tree.snapshot();
+	EXPECT_EQ(tree.insert(1, 1), SUCCESS);
+	ASSERT_TRUE(snapshot.is_valid());
+	EXPECT_EQ(snapshot.get_size(), 0);
+	EXPECT_EQ(snapshot.find(1).status(), FAILURE);
+	std::vector<Pair<int, int>> res = std::vector<Pair<int, int>>();
+	EXPECT_EQ(snapshot.to_vec(), res);
+}
+
+TEST_F(AVLTreeFixture, SnapshotUnchangedByWrites)
+{
+	auto snapshot = avlTree.snapshot();
+	
+	for (int i = 100; i < 200; ++i)
+	{
+		EXPECT_EQ(avlTree.insert(i, i), SUCCESS);
+	}
+	for (const auto& pair : vec)
+	{
+		EXPECT_EQ(avlTree.remove(pair.get_first()), SUCCESS);
+	}
+	ASSERT_TRUE(avlTree.is_valid());
+	EXPECT_EQ(avlTree.get_size(), 100);
+	
+	ASSERT_TRUE(snapshot.is_valid());
+	EXPECT_EQ(snapshot.get_size(), size);
+	EXPECT_EQ(snapshot.to_vec(), vec);
+	std::stringstream ss;
+	snapshot.inorder(ss);
+	EXPECT_EQ(ss.str(), str);
+	for (const auto& pair : vec)
+	{
+		auto res = snapshot.find(pair.get_first());
+		EXPECT_EQ(res.status(), SUCCESS);
+		EXPECT_EQ(res.ans(), pair.get_second());
+	}
+	EXPECT_EQ(snapshot.find(100).status(), FAILURE);
+}
+
+TEST_F(AVLTreeFixture, SnapshotKeepsPathExtra)
+{
+	avlTree.add_extra(8, 4);
+	auto snapshot = avlTree.snapshot();
+	avlTree.add_extra(4, -3);
+	for (int i = 20; i < 40; ++i)
+	{
+		avlTree.insert(i, i);
+	}
+	
+	for (const auto& pair : vec)
+	{
+		output_t<int> valueBySnapshot = snapshot.get_path_extra(pair.get_first());
+		EXPECT_EQ(valueBySnapshot.status(), SUCCESS);
+		EXPECT_EQ(valueBySnapshot.ans(), pair.get_first() > 8 ? 0 : 4);
+		
+		output_t<int> valueByTree = avlTree.get_path_extra(pair.get_first());
+		EXPECT_EQ(valueByTree.status(), SUCCESS);
+		if (pair.get_first() > 8)
+		{
+			EXPECT_EQ(valueByTree.ans(), 0);
+		}
+		else if (pair.get_first() > 4)
+		{
+			EXPECT_EQ(valueByTree.ans(), 4);
+		}
+		else
+		{
+			EXPECT_EQ(valueByTree.ans(), 1);
+		}
+	}
+}
+
+TEST(SUITE, SnapshotVersions)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	std::vector<decltype(tree.snapshot())> snapshots;
+	for (int i = 0; i < 50; ++i)
+	{
+		snapshots.push_back(tree.snapshot());
+		EXPECT_EQ(tree.insert(i, i * 10), SUCCESS);
+	}
+	for (int version = 0; version < 50; ++version)
+	{
+		auto& snapshot = snapshots[version];
+		ASSERT_TRUE(snapshot.is_valid());
+		EXPECT_EQ(snapshot.get_size(), version);
+		EXPECT_EQ(snapshot.find(version).status(), FAILURE);
+		if (version > 0)
+		{
+			EXPECT_EQ(snapshot.find(version - 1).ans(), (version - 1) * 10);
+		}
+	}
+}
+
+TEST(SUITE, SnapshotOutlivesTree)
+{
+	auto snapshot = []
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		for (int i = 0; i < 100; ++i)
+		{
+			tree.insert(i, i);
+		}
+		return tree.snapshot();
+	}();
+	ASSERT_TRUE(snapshot.is_valid());
+	EXPECT_EQ(snapshot.get_size(), 100);
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(snapshot.find(i).ans(), i);
+	}
+}
+
+TEST(SUITE, SnapshotNoLeaks)
+{
+	AllocationScope scope;
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		for (int i = 0; i < 100; ++i)
+		{
+			tree.insert(i, i);
+		}
+		auto first = tree.snapshot();
+		for (int i = 0; i < 100; i += 2)
+		{
+			tree.remove(i);
+		}
+		auto second = tree.snapshot();
+		tree.insert(1000, 1000);
+		{
+			auto third = tree.snapshot();
+			tree.remove(1000);
+		}
+		EXPECT_EQ(first.get_size(), 100);
+		EXPECT_EQ(second.get_size(), 50);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+#endif
+
+#ifdef DS2_TEST_AVL_SPLIT_JOIN
+// tree.split(key, left, right) moves the keys smaller than key into left and the rest into right, leaving tree empty.
+// tree.join(left, key, value, right) builds tree (which must be empty) from left, the pivot and right, leaving
+// left and right empty. Keys of left must be smaller than key and keys of right bigger, otherwise INVALID_INPUT.
+
+// Expected get_path_extra after add_extra(8, 4) and add_extra(4, -3) on the original keys
+static int expectedExtra(int key)
+{
+	if (key > 8)
+	{
+		return 0;
+	}
+	return key > 4 ? 4 : 1;
+}
+
+TEST_F(AVLTreeFixture, Split)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	EXPECT_EQ(avlTree.split(6, left, right), SUCCESS);
+	ASSERT_TRUE(left.is_valid());
+	ASSERT_TRUE(right.is_valid());
+	ASSERT_TRUE(avlTree.is_valid());
+	EXPECT_EQ(avlTree.get_size(), 0);
+	
+	std::vector<Pair<int, int>> leftVec(vec.begin(), vec.begin() + 5);
+	std::vector<Pair<int, int>> rightVec(vec.begin() + 5, vec.end());
+	EXPECT_EQ(left.to_vec(), leftVec);
+	EXPECT_EQ(right.to_vec(), rightVec);
+	EXPECT_EQ(left.get_size(), 5);
+	EXPECT_EQ(right.get_size(), size - 5);
+	EXPECT_EQ(left.get_max().ans(), 70);
+	EXPECT_EQ(right.get_min().ans(), 70);
+}
+
+TEST_F(AVLTreeFixture, SplitAtMissingKey)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	EXPECT_EQ(avlTree.split(3, left, right), SUCCESS);
+	ASSERT_TRUE(left.is_valid());
+	ASSERT_TRUE(right.is_valid());
+	EXPECT_EQ(left.get_size(), 3);
+	EXPECT_EQ(right.get_size(), size - 3);
+	EXPECT_EQ(left.find(2).status(), SUCCESS);
+	EXPECT_EQ(right.find(4).status(), SUCCESS);
+}
+
+TEST_F(AVLTreeFixture, SplitOutsideRange)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	EXPECT_EQ(avlTree.split(-5, left, right), SUCCESS);
+	ASSERT_TRUE(left.is_valid());
+	ASSERT_TRUE(right.is_valid());
+	EXPECT_EQ(left.get_size(), 0);
+	EXPECT_EQ(right.to_vec(), vec);
+	
+	AVL_Tree<int, int> left2 = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right2 = AVL_Tree<int, int>();
+	EXPECT_EQ(right.split(100, left2, right2), SUCCESS);
+	ASSERT_TRUE(left2.is_valid());
+	ASSERT_TRUE(right2.is_valid());
+	EXPECT_EQ(left2.to_vec(), vec);
+	EXPECT_EQ(right2.get_size(), 0);
+}
+
+TEST_F(AVLTreeFixture, SplitKeepsExtra)
+{
+	for (int splitKey : {0, 4, 5, 7, 9, 31})
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		for (const auto& pair : vec)
+		{
+			tree.insert(pair.get_first(), pair.get_second());
+		}
+		tree.add_extra(8, 4);
+		tree.add_extra(4, -3);
+		
+		AVL_Tree<int, int> left = AVL_Tree<int, int>();
+		AVL_Tree<int, int> right = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.split(splitKey, left, right), SUCCESS);
+		ASSERT_TRUE(left.is_valid());
+		ASSERT_TRUE(right.is_valid());
+		for (const auto& pair : vec)
+		{
+			auto& part = pair.get_first() < splitKey ? left : right;
+			output_t<int> valueByTree = part.get_path_extra(pair.get_first());
+			EXPECT_EQ(valueByTree.status(), SUCCESS);
+			EXPECT_EQ(valueByTree.ans(), expectedExtra(pair.get_first())) << "split at " << splitKey;
+		}
+	}
+}
+
+TEST(SUITE, Join)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	for (int i = 0; i < 10; ++i)
+	{
+		left.insert(i, i);
+	}
+	for (int i = 11; i < 500; ++i)
+	{
+		right.insert(i, i);
+	}
+	
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.join(left, 10, 10, right), SUCCESS);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), 500);
+	EXPECT_EQ(left.get_size(), 0);
+	EXPECT_EQ(right.get_size(), 0);
+	auto res = tree.to_vec();
+	for (int i = 0; i < 500; ++i)
+	{
+		EXPECT_EQ(res[i].get_first(), i);
+		EXPECT_EQ(res[i].get_second(), i);
+	}
+	
+	// Tall left, short right
+	AVL_Tree<int, int> tall = AVL_Tree<int, int>();
+	AVL_Tree<int, int> empty = AVL_Tree<int, int>();
+	AVL_Tree<int, int> joined = AVL_Tree<int, int>();
+	EXPECT_EQ(joined.join(tree, 1000, 1000, empty), SUCCESS);
+	ASSERT_TRUE(joined.is_valid());
+	EXPECT_EQ(joined.get_size(), 501);
+	EXPECT_EQ(joined.get_max().ans(), 1000);
+	EXPECT_EQ(tall.join(empty, -1, -1, joined), SUCCESS);
+	ASSERT_TRUE(tall.is_valid());
+	EXPECT_EQ(tall.get_size(), 502);
+	EXPECT_EQ(tall.get_min().ans(), -1);
+}
+
+TEST(SUITE, JoinInvalidOrder)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	for (int i = 0; i < 10; ++i)
+	{
+		left.insert(i, i);
+		right.insert(i + 20, i);
+	}
+	
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.join(left, 5, 5, right), StatusType::INVALID_INPUT);
+	EXPECT_EQ(tree.join(left, 25, 25, right), StatusType::INVALID_INPUT);
+	EXPECT_EQ(tree.join(right, 15, 15, left), StatusType::INVALID_INPUT);
+	EXPECT_EQ(tree.get_size(), 0);
+	EXPECT_EQ(left.get_size(), 10);
+	EXPECT_EQ(right.get_size(), 10);
+	ASSERT_TRUE(left.is_valid());
+	ASSERT_TRUE(right.is_valid());
+}
+
+TEST_F(AVLTreeFixture, JoinKeepsExtra)
+{
+	AVL_Tree<int, int> left = AVL_Tree<int, int>();
+	AVL_Tree<int, int> right = AVL_Tree<int, int>();
+	avlTree.add_extra(8, 4);
+	avlTree.add_extra(4, -3);
+	EXPECT_EQ(avlTree.split(6, left, right), SUCCESS);
+	EXPECT_EQ(right.remove(6), SUCCESS);
+	for (int i = 100; i < 140; ++i)
+	{
+		right.insert(i, i);
+	}
+	
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.join(left, 6, 70, right), SUCCESS);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), size + 40);
+	for (const auto& pair : vec)
+	{
+		output_t<int> valueByTree = tree.get_path_extra(pair.get_first());
+		EXPECT_EQ(valueByTree.status(), SUCCESS);
+		// The pivot is a new node and starts without extra
+		EXPECT_EQ(valueByTree.ans(), pair.get_first() == 6 ? 0 : expectedExtra(pair.get_first()));
+	}
+	for (int i = 100; i < 140; ++i)
+	{
+		EXPECT_EQ(tree.get_path_extra(i).ans(), 0);
+	}
+}
+
+TEST(SUITE, SplitJoinRoundTrip)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	for (int i = 0; i < 1000; ++i)
+	{
+		tree.insert((i * 37) % 1000, i);
+	}
+	auto original = tree.to_vec();
+	
+	for (int key : {1, 250, 500, 998})
+	{
+		AVL_Tree<int, int> left = AVL_Tree<int, int>();
+		AVL_Tree<int, int> right = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.split(key, left, right), SUCCESS);
+		int value = right.find(key).ans();
+		EXPECT_EQ(right.remove(key), SUCCESS);
+		EXPECT_EQ(tree.join(left, key, value, right), SUCCESS);
+		ASSERT_TRUE(tree.is_valid());
+		EXPECT_EQ(tree.to_vec(), original);
+	}
+}
+#endif
+
+#ifdef DS2_TEST_AVL_EXPORT
+// tree.export_columns(path, deltaKeys) writes the keys and then the values of the tree in order, as fixed-width
+// columns (keys optionally delta-encoded). tree.import_columns(path) builds an empty tree from such a file
+// through the sorted-array constructor. Importing into a non-empty tree is INVALID_INPUT, a missing or
+// malformed file is FAILURE.
+
+static std::string exportPath(const std::string& name)
+{
+	return ::testing::TempDir() + "ds2_" + name + ".cols";
+}
+
+TEST_F(AVLTreeFixture, ExportImportRoundTrip)
+{
+	for (bool deltaKeys : {false, true})
+	{
+		std::string path = exportPath(deltaKeys ? "fixture_delta" : "fixture");
+		EXPECT_EQ(avlTree.export_columns(path.c_str(), deltaKeys), SUCCESS);
+		
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.import_columns(path.c_str()), SUCCESS);
+		ASSERT_TRUE(tree.is_valid());
+		EXPECT_EQ(tree.get_size(), size);
+		EXPECT_EQ(tree.to_vec(), vec);
+		std::stringstream ss;
+		tree.inorder(ss);
+		EXPECT_EQ(ss.str(), str);
+		std::remove(path.c_str());
+	}
+}
+
+TEST(SUITE, ExportImportEmptyTree)
+{
+	std::string path = exportPath("empty");
+	AVL_Tree<int, int> empty = AVL_Tree<int, int>();
+	EXPECT_EQ(empty.export_columns(path.c_str(), true), SUCCESS);
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.import_columns(path.c_str()), SUCCESS);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), 0);
+	std::remove(path.c_str());
+}
+
+TEST(SUITE, ExportImportLargeTree)
+{
+	AVL_Tree<long long, int> tree = AVL_Tree<long long, int>();
+	for (int i = 0; i < 100000; ++i)
+	{
+		// Negative keys and large gaps between keys, for the delta encoding
+		tree.insert((static_cast<long long>(i) - 50000) * 1000003, i);
+	}
+	for (bool deltaKeys : {false, true})
+	{
+		std::string path = exportPath(deltaKeys ? "large_delta" : "large");
+		EXPECT_EQ(tree.export_columns(path.c_str(), deltaKeys), SUCCESS);
+		AVL_Tree<long long, int> imported = AVL_Tree<long long, int>();
+		EXPECT_EQ(imported.import_columns(path.c_str()), SUCCESS);
+		ASSERT_TRUE(imported.is_valid());
+		EXPECT_EQ(imported.get_size(), tree.get_size());
+		EXPECT_TRUE(imported.to_vec() == tree.to_vec());
+		std::remove(path.c_str());
+	}
+}
+
+TEST_F(AVLTreeFixture, ImportIntoNonEmptyTree)
+{
+	std::string path = exportPath("non_empty");
+	EXPECT_EQ(avlTree.export_columns(path.c_str(), false), SUCCESS);
+	EXPECT_EQ(avlTree.import_columns(path.c_str()), StatusType::INVALID_INPUT);
+	EXPECT_EQ(avlTree.to_vec(), vec);
+	std::remove(path.c_str());
+}
+
+TEST_F(AVLTreeFixture, ImportMissingOrTruncatedFile)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.import_columns(exportPath("does_not_exist").c_str()), FAILURE);
+	EXPECT_EQ(tree.get_size(), 0);
+	
+	std::string path = exportPath("truncated");
+	EXPECT_EQ(avlTree.export_columns(path.c_str(), false), SUCCESS);
+	std::string contents;
+	{
+		std::ifstream in(path, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(contents.data(), contents.size() / 2);
+	}
+	EXPECT_EQ(tree.import_columns(path.c_str()), FAILURE);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), 0);
+	std::remove(path.c_str());
+}
+#endif
+
+#ifdef DS2_TEST_MEMORY_POLICY
+// set_memory_policy(hugePages, numaNode) chooses how an empty tree allocates its node pool, see the HashTable tests.
+
+TEST(SUITE, MemoryPolicy)
+{
+	for (int numaNode : {-1, 0, 1000})
+	{
+		for (bool hugePages : {false, true})
+		{
+			AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+			EXPECT_EQ(tree.set_memory_policy(hugePages, numaNode), SUCCESS);
+			for (int i = 0; i < 10000; ++i)
+			{
+				EXPECT_EQ(tree.insert(i, i), SUCCESS);
+			}
+			for (int i = 0; i < 10000; i += 2)
+			{
+				EXPECT_EQ(tree.remove(i), SUCCESS);
+			}
+			ASSERT_TRUE(tree.is_valid());
+			EXPECT_EQ(tree.get_size(), 5000);
+			EXPECT_EQ(tree.get_min().ans(), 1);
+			EXPECT_EQ(tree.get_max().ans(), 9999);
+			tree.add_extra(5000, 3);
+			EXPECT_EQ(tree.get_path_extra(4999).ans(), 3);
+			EXPECT_EQ(tree.get_path_extra(5001).ans(), 0);
+		}
+	}
+}
+
+// Test that both heap memory and pages mapped by the tree itself are given back under the huge page policy
+TEST(SUITE, MemoryPolicyNoLeaks)
+{
+	AllocationScope scope;
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.set_memory_policy(true, -1), SUCCESS);
+		for (int i = 0; i < 100000; ++i)
+		{
+			tree.insert(i, i);
+		}
+		for (int i = 0; i < 100000; i += 2)
+		{
+			tree.remove(i);
+		}
+		EXPECT_GT(scope.liveBytes() + scope.mappedBytes(), 0);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.mappedBytes(), 0);
+}
+
+TEST_F(AVLTreeFixture, MemoryPolicyNonEmptyTree)
+{
+	EXPECT_EQ(avlTree.set_memory_policy(true, -1), FAILURE);
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.set_memory_policy(true, -2), StatusType::INVALID_INPUT);
+	EXPECT_EQ(avlTree.to_vec(), vec);
+}
+#endif
+
+#ifdef DS2_TEST_AVL_BULK_BUILD
+// tree.bulk_build(values, keys, n, threads) builds an empty tree from unsorted arrays, sorting them (radix sort for
+// integral keys, merge sort otherwise) and building the subtrees on up to `threads` threads. The arrays are not
+// modified. Duplicate keys are INVALID_INPUT and leave the tree empty, a non-empty tree is FAILURE.
+
+// Distinct keys in a random order, including negative ones
+static std::vector<int> shuffledDistinctKeys(int n, unsigned seed)
+{
+	std::vector<int> keys(n);
+	for (int i = 0; i < n; ++i)
+	{
+		keys[i] = (i - n / 2) * 7;
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+	return keys;
+}
+
+TEST_F(AVLTreeFixture, BulkBuildFromUnsortedArray)
+{
+	std::vector<Pair<int, int>> shuffled = vec;
+	std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(2024));
+	std::vector<int> values(shuffled.size());
+	std::vector<int> keys(shuffled.size());
+	for (int i = 0; i < shuffled.size(); ++i)
+	{
+		keys[i] = shuffled[i].get_first();
+		values[i] = shuffled[i].get_second();
+	}
+	
+	for (int threads : {1, 2, 4, 8})
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.bulk_build(values.data(), keys.data(), shuffled.size(), threads), SUCCESS) << threads << " threads";
+		ASSERT_TRUE(tree.is_valid()) << threads << " threads";
+		EXPECT_EQ(tree.to_vec(), vec) << threads << " threads";
+		std::stringstream ss;
+		tree.inorder(ss);
+		EXPECT_EQ(ss.str(), str) << threads << " threads";
+		EXPECT_EQ(tree.get_min().ans(), vec[0].get_second());
+		EXPECT_EQ(tree.get_max().ans(), vec[vec.size() - 1].get_second());
+	}
+	for (int i = 0; i < shuffled.size(); ++i)
+	{
+		EXPECT_EQ(keys[i], shuffled[i].get_first()) << "bulk_build modified its input";
+		EXPECT_EQ(values[i], shuffled[i].get_second()) << "bulk_build modified its input";
+	}
+}
+
+TEST(SUITE, BulkBuildFromEmptyArray)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.bulk_build(nullptr, nullptr, 0, 4), SUCCESS);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), 0);
+	EXPECT_EQ(tree.get_min().status(), FAILURE);
+}
+
+TEST(SUITE, BulkBuildLargeArray)
+{
+	const int n = 200000;
+	std::vector<int> keys = shuffledDistinctKeys(n, 2024);
+	std::vector<int> values(n);
+	for (int i = 0; i < n; ++i)
+	{
+		values[i] = keys[i] * 3;
+	}
+	std::vector<int> sorted = keys;
+	std::sort(sorted.begin(), sorted.end());
+	
+	for (int threads : {1, 3, 8, 32})
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.bulk_build(values.data(), keys.data(), n, threads), SUCCESS) << threads << " threads";
+		ASSERT_TRUE(tree.is_valid()) << threads << " threads";
+		EXPECT_EQ(tree.get_size(), n);
+		auto res = tree.to_vec();
+		ASSERT_EQ(res.size(), n);
+		int mismatches = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			mismatches += res[i].get_first() != sorted[i] || res[i].get_second() != sorted[i] * 3;
+		}
+		EXPECT_EQ(mismatches, 0) << threads << " threads";
+		EXPECT_EQ(tree.insert(sorted[0] - 1, 0), SUCCESS);
+		EXPECT_EQ(tree.remove(sorted[n / 2]), SUCCESS);
+		ASSERT_TRUE(tree.is_valid()) << "after updating a bulk built tree";
+	}
+}
+
+// Keys that are not integral, as in teamsByStrength, go through the comparison-based sort
+TEST(SUITE, BulkBuildPairKeys)
+{
+	const int n = 50000;
+	std::vector<int> ids = shuffledDistinctKeys(n, 7);
+	std::vector<Pair<int, int>> keys;
+	std::vector<int> values;
+	for (int id : ids)
+	{
+		// {teamId, strength} as in teamsByStrength, with few distinct strengths so most of the order comes from the id
+		keys.emplace_back(id, id % 100);
+		values.push_back(id);
+	}
+	
+	AVL_Tree<Pair<int, int>, int> tree = AVL_Tree<Pair<int, int>, int>();
+	EXPECT_EQ(tree.bulk_build(values.data(), keys.data(), n, 4), SUCCESS);
+	ASSERT_TRUE(tree.is_valid());
+	EXPECT_EQ(tree.get_size(), n);
+	auto res = tree.to_vec();
+	for (int i = 1; i < res.size(); ++i)
+	{
+		ASSERT_TRUE(res[i - 1].get_first() < res[i].get_first()) << "to_vec is out of order at index " << i;
+	}
+	for (int i = 0; i < n; i += 97)
+	{
+		auto found = tree.find(keys[i]);
+		EXPECT_EQ(found.status(), SUCCESS);
+		EXPECT_EQ(found.ans(), values[i]);
+	}
+}
+
+TEST(SUITE, BulkBuildDuplicateKeys)
+{
+	AllocationScope scope;
+	{
+		const int n = 100000;
+		std::vector<int> keys = shuffledDistinctKeys(n, 11);
+		std::vector<int> values(n, 1);
+		// One duplicate, far from its twin in the input
+		keys[n - 1] = keys[0];
+		for (int threads : {1, 8})
+		{
+			AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+			EXPECT_EQ(tree.bulk_build(values.data(), keys.data(), n, threads), StatusType::INVALID_INPUT);
+			ASSERT_TRUE(tree.is_valid());
+			EXPECT_EQ(tree.get_size(), 0);
+			EXPECT_EQ(tree.find(keys[1]).status(), FAILURE);
+		}
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+}
+
+TEST_F(AVLTreeFixture, BulkBuildInvalidInput)
+{
+	int keys[] = {3, 1, 2};
+	int values[] = {30, 10, 20};
+	EXPECT_EQ(avlTree.bulk_build(values, keys, 3, 2), FAILURE);
+	EXPECT_EQ(avlTree.to_vec(), vec);
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.bulk_build(values, keys, -1, 2), StatusType::INVALID_INPUT);
+	EXPECT_EQ(tree.bulk_build(values, keys, 3, 0), StatusType::INVALID_INPUT);
+	EXPECT_EQ(tree.get_size(), 0);
+}
+
+// Path extras start at 0 everywhere and work as in an inserted tree
+TEST(SUITE, BulkBuildKeepsExtra)
+{
+	const int n = 1000;
+	std::vector<int> keys = shuffledDistinctKeys(n, 5);
+	std::vector<int> values(keys);
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	EXPECT_EQ(tree.bulk_build(values.data(), keys.data(), n, 4), SUCCESS);
+	for (int key : keys)
+	{
+		EXPECT_EQ(tree.get_path_extra(key).ans(), 0);
+	}
+	tree.add_extra(0, 5);
+	for (int key : keys)
+	{
+		EXPECT_EQ(tree.get_path_extra(key).ans(), key <= 0 ? 5 : 0) << "key " << key;
+	}
+}
+
+TEST(SUITE, BulkBuildNoLeaks)
+{
+	AllocationScope scope;
+	{
+		std::vector<int> keys = shuffledDistinctKeys(100000, 3);
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		EXPECT_EQ(tree.bulk_build(keys.data(), keys.data(), keys.size(), 8), SUCCESS);
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+}
+#endif
+
+#ifdef DS2_TEST_AVL_RELAXED_BALANCE
+// tree.set_relaxed_balance(true) defers rebalancing: insert and remove only record balance violations, counted by
+// get_pending_rebalances(), and tree.flush() fixes all of them. find, get_min, get_max, to_vec, add_extra and
+// get_path_extra stay correct while rebalancing is pending; is_valid() is only expected to hold after a flush.
+// set_relaxed_balance(false) flushes and goes back to rebalancing on every operation.
+
+// Path extra of every key, as add_extra(key, extra) and insertions should leave them
+class ExtraReference
+{
+public:
+	void insert(int key)
+	{
+		extras.emplace(key, 0);
+	}
+	
+	void remove(int key)
+	{
+		extras.erase(key);
+	}
+	
+	void add_extra(int key, int extra)
+	{
+		for (auto it = extras.begin(); it != extras.end() && it->first <= key; ++it)
+		{
+			it->second += extra;
+		}
+	}
+	
+	std::map<int, int> extras;
+};
+
+// Checks find, min, max and path extras of every key against the reference
+static void expectMatchesReference(AVL_Tree<int, int>& tree, const ExtraReference& reference, const std::string& when)
+{
+	ASSERT_EQ(tree.get_size(), static_cast<int>(reference.extras.size())) << when;
+	if (reference.extras.empty())
+	{
+		return;
+	}
+	EXPECT_EQ(tree.get_min().ans(), reference.extras.begin()->first) << when;
+	EXPECT_EQ(tree.get_max().ans(), reference.extras.rbegin()->first) << when;
+	int mismatches = 0;
+	for (const auto& pair : reference.extras)
+	{
+		auto found = tree.find(pair.first);
+		auto extra = tree.get_path_extra(pair.first);
+		mismatches += found.status() != SUCCESS || found.ans() != pair.first;
+		mismatches += extra.status() != SUCCESS || extra.ans() != pair.second;
+	}
+	EXPECT_EQ(mismatches, 0) << when;
+}
+
+TEST(SUITE, RelaxedBalanceSortedBurst)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	tree.set_relaxed_balance(true);
+	ExtraReference reference;
+	for (int key = 0; key < 20000; ++key)
+	{
+		EXPECT_EQ(tree.insert(key, key), SUCCESS);
+		reference.insert(key);
+		if (key % 5000 == 4999)
+		{
+			expectMatchesReference(tree, reference, "after inserting " + std::to_string(key + 1) + " sorted keys");
+		}
+	}
+	EXPECT_EQ(tree.insert(100, 100), FAILURE);
+	EXPECT_GT(tree.get_pending_rebalances(), 0) << "sorted inserts were rebalanced immediately";
+	
+	tree.flush();
+	EXPECT_EQ(tree.get_pending_rebalances(), 0);
+	ASSERT_TRUE(tree.is_valid());
+	expectMatchesReference(tree, reference, "after flush");
+}
+
+TEST(SUITE, RelaxedBalanceRandomOperations)
+{
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	tree.set_relaxed_balance(true);
+	ExtraReference reference;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> key(0, 5000);
+	std::uniform_int_distribution<int> extra(-10, 10);
+	std::uniform_int_distribution<int> kind(0, 99);
+	for (int i = 0; i < 40000; ++i)
+	{
+		int k = kind(gen);
+		int x = key(gen);
+		if (k < 50)
+		{
+			auto expected = reference.extras.count(x) ? FAILURE : SUCCESS;
+			EXPECT_EQ(tree.insert(x, x), expected) << "insert " << x;
+			reference.insert(x);
+		}
+		else if (k < 85)
+		{
+			auto expected = reference.extras.count(x) ? SUCCESS : FAILURE;
+			EXPECT_EQ(tree.remove(x), expected) << "remove " << x;
+			reference.remove(x);
+		}
+		else if (k < 99)
+		{
+			// add_extra is only specified for keys in the tree, so use the first present key from x on
+			auto present = reference.extras.lower_bound(x);
+			if (present != reference.extras.end())
+			{
+				int e = extra(gen);
+				EXPECT_EQ(tree.add_extra(present->first, e), SUCCESS) << "add_extra " << present->first;
+				reference.add_extra(present->first, e);
+			}
+		}
+		else
+		{
+			tree.flush();
+			ASSERT_TRUE(tree.is_valid()) << "after flush at operation #" << i;
+		}
+		if (i % 4000 == 3999)
+		{
+			expectMatchesReference(tree, reference, "operation #" + std::to_string(i));
+		}
+	}
+	tree.flush();
+	ASSERT_TRUE(tree.is_valid());
+	expectMatchesReference(tree, reference, "final flush");
+}
+
+TEST_F(AVLTreeFixture, RelaxedBalanceKeepsExtra)
+{
+	avlTree.set_relaxed_balance(true);
+	avlTree.add_extra(8, 4);
+	for (int key = 100; key < 200; ++key)
+	{
+		avlTree.insert(key, key);
+	}
+	avlTree.add_extra(4, -3);
+	EXPECT_EQ(avlTree.remove(30), SUCCESS);
+	for (const auto& pair : vec)
+	{
+		if (pair.get_first() == 30)
+		{
+			EXPECT_EQ(avlTree.get_path_extra(30).status(), FAILURE);
+			continue;
+		}
+		int expected = pair.get_first() > 8 ? 0 : pair.get_first() > 4 ? 4 : 1;
+		EXPECT_EQ(avlTree.get_path_extra(pair.get_first()).ans(), expected) << "before flush, key " << pair.get_first();
+	}
+	avlTree.flush();
+	ASSERT_TRUE(avlTree.is_valid());
+	for (const auto& pair : vec)
+	{
+		if (pair.get_first() != 30)
+		{
+			int expected = pair.get_first() > 8 ? 0 : pair.get_first() > 4 ? 4 : 1;
+			EXPECT_EQ(avlTree.get_path_extra(pair.get_first()).ans(), expected) << "after flush, key "
+																				  << pair.get_first();
+		}
+	}
+	for (int key = 100; key < 200; ++key)
+	{
+		EXPECT_EQ(avlTree.get_path_extra(key).ans(), 0);
+	}
+}
+
+TEST_F(AVLTreeFixture, RelaxedBalanceTurnedOff)
+{
+	avlTree.set_relaxed_balance(true);
+	for (int key = 100; key < 1100; ++key)
+	{
+		avlTree.insert(key, key);
+	}
+	avlTree.set_relaxed_balance(false);
+	EXPECT_EQ(avlTree.get_pending_rebalances(), 0);
+	ASSERT_TRUE(avlTree.is_valid());
+	for (int key = 1100; key < 1200; ++key)
+	{
+		avlTree.insert(key, key);
+		ASSERT_TRUE(avlTree.is_valid()) << "strict mode did not rebalance after inserting " << key;
+		ASSERT_EQ(avlTree.get_pending_rebalances(), 0);
+	}
+	
+	// Flushing a balanced tree changes nothing
+	avlTree.flush();
+	ASSERT_TRUE(avlTree.is_valid());
+	EXPECT_EQ(avlTree.get_size(), size + 1100);
+	EXPECT_EQ(avlTree.get_min().ans(), vec[0].get_second());
+}
+
+TEST(SUITE, RelaxedBalanceNoLeaks)
+{
+	AllocationScope scope;
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		tree.set_relaxed_balance(true);
+		for (int key = 0; key < 10000; ++key)
+		{
+			tree.insert(key, key);
+		}
+		for (int key = 0; key < 10000; key += 2)
+		{
+			tree.remove(key);
+		}
+		tree.flush();
+		for (int key = 1; key < 10000; key += 4)
+		{
+			tree.remove(key);
+		}
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+}
+#endif
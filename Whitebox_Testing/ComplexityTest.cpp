@@ -0,0 +1,314 @@
+//
+// Empirical complexity tests: run each operation at sizes 2^10..2^20 and check the per-operation counters from
+// OpCounters.h against the promised O(log n) / O(1) growth, so a remove that became O(n) or a rehash policy
+// that never fires fails like a correctness bug.
+// Requires AVL_Tree and HashTable to call DS2_COUNT (see OpCounters.h).
+//
+
+#ifdef DS2_TEST_OP_COUNTERS
+#include "../../wet2util.h"
+#include "../lib/googletest/include/gtest/gtest.h"
+#include "../../AVL_Tree.h"
+#include "../../HashTable.h"
+#ifdef DS2_TEST_CUCKOO_HASH
+#include "../../CuckooHashTable.h"
+#endif
+#include "../OpCounters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#define SUCCESS StatusType::SUCCESS
+#define FAILURE StatusType::FAILURE
+#define SUITE ComplexityTest
+
+// Sizes 2^10, 2^12, ..., 2^20
+static std::vector<int> sizes()
+{
+	std::vector<int> res;
+	for (int exp = 10; exp <= 20; exp += 2)
+	{
+		res.push_back(1 << exp);
+	}
+	return res;
+}
+
+static std::vector<int> shuffledKeys(int n)
+{
+	std::vector<int> keys(n);
+	for (int i = 0; i < n; ++i)
+	{
+		keys[i] = i;
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(n));
+	return keys;
+}
+
+// An AVL tree of n nodes is at most 1.45 * log2(n + 2) high
+static double avlHeight(int n)
+{
+	return 1.45 * std::log2(n + 2.0);
+}
+
+// Per-operation cost of some counter at each size
+struct Growth
+{
+	std::vector<int> n;
+	std::vector<double> perOp;
+	
+	void add(int size, unsigned long long total, int ops)
+	{
+		n.push_back(size);
+		perOp.push_back(static_cast<double>(total) / ops);
+	}
+	
+	// Cost at the biggest size relative to the smallest
+	double ratio() const
+	{
+		return perOp.front() > 0 ? perOp.back() / perOp.front() : 0;
+	}
+};
+
+static std::string describe(const Growth& growth)
+{
+	std::string res;
+	for (size_t i = 0; i < growth.n.size(); ++i)
+	{
+		res += "n=" + std::to_string(growth.n[i]) + ": " + std::to_string(growth.perOp[i]) + " per op\n";
+	}
+	return res;
+}
+
+// Per-size bounds are ASSERTs, so an operation that became linear fails at the smallest size instead of running
+// for a long time at the biggest one.
+// Between 2^10 and 2^20 log n doubles; anything linear grows 1024 times
+#define MAX_LOG_RATIO 3.0
+#define MAX_CONSTANT_RATIO 2.0
+
+TEST(SUITE, AVLTreeInsert)
+{
+	Growth comparisons;
+	Growth rotations;
+	for (int n : sizes())
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		OpCounters before = opCounters();
+		for (int key : shuffledKeys(n))
+		{
+			tree.insert(key, key);
+		}
+		OpCounters diff = opCounters() - before;
+		comparisons.add(n, diff.comparisons, n);
+		rotations.add(n, diff.rotations, n);
+		ASSERT_LE(comparisons.perOp.back(), 2 * avlHeight(n) + 2) << describe(comparisons);
+		// At most one (single or double) rotation per insert
+		ASSERT_LE(rotations.perOp.back(), 2) << describe(rotations);
+	}
+	EXPECT_GT(comparisons.perOp.front(), 0) << "AVL_Tree does not count comparisons";
+	EXPECT_LE(comparisons.ratio(), MAX_LOG_RATIO) << describe(comparisons);
+}
+
+TEST(SUITE, AVLTreeSortedInsertRotates)
+{
+	for (int n : sizes())
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		OpCounters before = opCounters();
+		for (int key = 0; key < n; ++key)
+		{
+			tree.insert(key, key);
+		}
+		OpCounters diff = opCounters() - before;
+		// A sorted insert sequence cannot stay balanced without rotating
+		EXPECT_GE(diff.rotations, static_cast<unsigned long long>(n / 2)) << "n=" << n;
+		EXPECT_LE(diff.rotations, static_cast<unsigned long long>(2 * n)) << "n=" << n;
+		ASSERT_TRUE(tree.is_valid());
+	}
+}
+
+TEST(SUITE, AVLTreeFind)
+{
+	Growth visited;
+	for (int n : sizes())
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		std::vector<int> keys = shuffledKeys(n);
+		for (int key : keys)
+		{
+			tree.insert(key, key);
+		}
+		int found = 0;
+		OpCounters before = opCounters();
+		for (int key : keys)
+		{
+			found += tree.find(key).status() == SUCCESS;
+			found += tree.find(-key - 1).status() == SUCCESS;
+		}
+		OpCounters diff = opCounters() - before;
+		EXPECT_EQ(found, n);
+		visited.add(n, diff.nodesVisited, 2 * n);
+		ASSERT_LE(visited.perOp.back(), avlHeight(n) + 1) << describe(visited);
+	}
+	EXPECT_GT(visited.perOp.front(), 0) << "AVL_Tree does not count visited nodes";
+	EXPECT_LE(visited.ratio(), MAX_LOG_RATIO) << describe(visited);
+}
+
+TEST(SUITE, AVLTreeRemove)
+{
+	Growth visited;
+	Growth rotations;
+	for (int n : sizes())
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		std::vector<int> keys = shuffledKeys(n);
+		for (int key : keys)
+		{
+			tree.insert(key, key);
+		}
+		std::reverse(keys.begin(), keys.end());
+		OpCounters before = opCounters();
+		for (int key : keys)
+		{
+			tree.remove(key);
+		}
+		OpCounters diff = opCounters() - before;
+		visited.add(n, diff.nodesVisited, n);
+		rotations.add(n, diff.rotations, n);
+		ASSERT_LE(visited.perOp.back(), 3 * avlHeight(n) + 3) << describe(visited);
+		ASSERT_LE(rotations.perOp.back(), 2 * avlHeight(n)) << describe(rotations);
+		EXPECT_EQ(tree.get_size(), 0);
+	}
+	EXPECT_LE(visited.ratio(), MAX_LOG_RATIO) << describe(visited);
+}
+
+TEST(SUITE, AVLTreePathExtra)
+{
+	Growth visited;
+	for (int n : sizes())
+	{
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		std::vector<int> keys = shuffledKeys(n);
+		for (int key : keys)
+		{
+			tree.insert(key, key);
+		}
+		OpCounters before = opCounters();
+		for (int i = 0; i < n; ++i)
+		{
+			tree.add_extra(keys[i], 1);
+			tree.get_path_extra(keys[n - 1 - i]);
+		}
+		OpCounters diff = opCounters() - before;
+		visited.add(n, diff.nodesVisited, 2 * n);
+		ASSERT_LE(visited.perOp.back(), 2 * avlHeight(n) + 2) << describe(visited);
+	}
+	EXPECT_LE(visited.ratio(), MAX_LOG_RATIO) << describe(visited);
+}
+
+TEST(SUITE, HashTableFind)
+{
+	Growth probes;
+	for (int n : sizes())
+	{
+		HashTable<int, int> table;
+		std::vector<int> keys = shuffledKeys(n);
+		for (int key : keys)
+		{
+			table.insert(key, key);
+		}
+		int found = 0;
+		OpCounters before = opCounters();
+		for (int key : keys)
+		{
+			found += table.find(key).status() == SUCCESS;
+			found += table.find(key + n).status() == SUCCESS;
+		}
+		OpCounters diff = opCounters() - before;
+		EXPECT_EQ(found, n);
+		probes.add(n, diff.probes, 2 * n);
+		ASSERT_LE(probes.perOp.back(), 4) << describe(probes);
+	}
+	EXPECT_GT(probes.perOp.front(), 0) << "HashTable does not count probes";
+	EXPECT_LE(probes.ratio(), MAX_CONSTANT_RATIO) << describe(probes);
+}
+
+TEST(SUITE, HashTableInsertRemove)
+{
+	Growth probes;
+	for (int n : sizes())
+	{
+		HashTable<int, int> table;
+		std::vector<int> keys = shuffledKeys(n);
+		OpCounters before = opCounters();
+		for (int key : keys)
+		{
+			table.insert(key, key);
+		}
+		for (int key : keys)
+		{
+			table.remove(key);
+		}
+		OpCounters diff = opCounters() - before;
+		probes.add(n, diff.probes, 2 * n);
+		ASSERT_LE(probes.perOp.back(), 4) << describe(probes);
+		EXPECT_EQ(table.get_size(), 0);
+	}
+	EXPECT_LE(probes.ratio(), MAX_CONSTANT_RATIO) << describe(probes);
+}
+
+TEST(SUITE, HashTableRehashes)
+{
+	for (int n : sizes())
+	{
+		HashTable<int, int> table;
+		OpCounters before = opCounters();
+		for (int key = 0; key < n; ++key)
+		{
+			table.insert(key, key);
+		}
+		OpCounters diff = opCounters() - before;
+		// The table must grow geometrically: some resizes, but O(log n) of them
+		EXPECT_GE(diff.rehashes, 1ULL) << "no rehash after " << n << " inserts";
+		EXPECT_LE(diff.rehashes, static_cast<unsigned long long>(2 * std::log2(n) + 2)) << "n=" << n;
+	}
+}
+
+#ifdef DS2_TEST_CUCKOO_HASH
+// Every CuckooHashTable lookup, hit or miss, examines at most the two candidate buckets of its key, at every size and
+// also for keys that share their low bits
+TEST(SUITE, CuckooHashTableFindTwoProbes)
+{
+	for (int shift : {0, 10})
+	{
+		unsigned long long totalProbes = 0;
+		for (int n : sizes())
+		{
+			CuckooHashTable<int, int> table;
+			std::vector<int> keys = shuffledKeys(n);
+			for (int key : keys)
+			{
+				table.insert(key << shift, key);
+			}
+			unsigned long long maxProbes = 0;
+			int found = 0;
+			for (int key : keys)
+			{
+				for (int probe : {key << shift, (key + n) << shift})
+				{
+					OpCounters before = opCounters();
+					found += table.find(probe).status() == SUCCESS;
+					unsigned long long probes = (opCounters() - before).probes;
+					maxProbes = std::max(maxProbes, probes);
+					totalProbes += probes;
+				}
+			}
+			EXPECT_EQ(found, n);
+			ASSERT_LE(maxProbes, 2ULL) << "n=" << n << ", keys shifted by " << shift;
+		}
+		EXPECT_GT(totalProbes, 0ULL) << "CuckooHashTable does not count probes";
+	}
+}
+#endif
+#endif
@@ -0,0 +1,40 @@
+//
+// Tests specific to CompressedIdIndex<V>. The ordered index contract it shares with IntegerOrderedSet<V> is tested
+// in OrderedIdIndexTest.cpp.
+//
+
+#ifdef DS2_TEST_COMPRESSED_ID_INDEX
+#include "../../wet2util.h"
+#include "../lib/googletest/include/gtest/gtest.h"
+#include "../../CompressedIdIndex.h"
+#include "../../AVL_Tree.h"
+#include "../AllocationTracker.h"
+
+#define SUITE CompressedIdIndexTest
+
+TEST(SUITE, SmallerThanAVLTreeForDenseIds)
+{
+	const int n = 100000;
+	long long indexBytes;
+	long long treeBytes;
+	{
+		AllocationScope scope;
+		CompressedIdIndex<int> index = CompressedIdIndex<int>();
+		for (int id = 1; id <= n; ++id)
+		{
+			index.insert(id, id);
+		}
+		indexBytes = scope.liveBytes();
+	}
+	{
+		AllocationScope scope;
+		AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+		for (int id = 1; id <= n; ++id)
+		{
+			tree.insert(id, id);
+		}
+		treeBytes = scope.liveBytes();
+	}
+	EXPECT_LT(indexBytes, treeBytes) << "bytes per id: index " << indexBytes / n << ", AVL_Tree " << treeBytes / n;
+}
+#endif
@@ -0,0 +1,72 @@
+//
+// Tests specific to IntegerOrderedSet<V>, an ordered map over bounded non-negative int keys (van Emde Boas / y-fast
+// trie or a 64-ary bitset tree) with predecessor and successor in O(log log U).
+// IntegerOrderedSet<V>() takes keys 0..INT_MAX, IntegerOrderedSet<V>(maxKey) keys 0..maxKey; other keys are
+// INVALID_INPUT. The ordered index contract it shares with CompressedIdIndex<V> is tested in OrderedIdIndexTest.cpp.
+//
+
+#ifdef DS2_TEST_INTEGER_ORDERED_SET
+#include "../../wet2util.h"
+#include "../lib/googletest/include/gtest/gtest.h"
+#include "../../IntegerOrderedSet.h"
+
+#define SUCCESS StatusType::SUCCESS
+#define FAILURE StatusType::FAILURE
+#define SUITE IntegerOrderedSetTest
+
+TEST(SUITE, BoundedUniverse)
+{
+	const int maxKey = 1000;
+	IntegerOrderedSet<int> set = IntegerOrderedSet<int>(maxKey);
+	EXPECT_EQ(set.insert(-1, 0), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.insert(maxKey + 1, 0), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.insert(maxKey, 1), SUCCESS);
+	EXPECT_EQ(set.insert(0, 2), SUCCESS);
+	EXPECT_EQ(set.find(maxKey + 1).status(), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.remove(-1), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.predecessor(-1).status(), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.successor(maxKey + 1).status(), StatusType::INVALID_INPUT);
+	EXPECT_EQ(set.successor(0).ans(), maxKey);
+	EXPECT_EQ(set.predecessor(maxKey).ans(), 0);
+	EXPECT_EQ(set.get_size(), 2);
+}
+
+// Every key of a small universe, walked in both directions and then removed
+TEST(SUITE, FullUniverse)
+{
+	const int maxKey = (1 << 16) - 1;
+	IntegerOrderedSet<int> set = IntegerOrderedSet<int>(maxKey);
+	for (int key = maxKey; key >= 0; --key)
+	{
+		ASSERT_EQ(set.insert(key, key), SUCCESS) << key;
+	}
+	EXPECT_EQ(set.get_size(), maxKey + 1);
+	int key = 0;
+	for (int i = 1; i <= maxKey; ++i)
+	{
+		auto next = set.successor(key);
+		ASSERT_EQ(next.status(), SUCCESS) << key;
+		ASSERT_EQ(next.ans(), key + 1);
+		key = next.ans();
+	}
+	EXPECT_EQ(set.successor(maxKey).status(), FAILURE);
+	for (int i = 1; i <= maxKey; ++i)
+	{
+		auto next = set.predecessor(key);
+		ASSERT_EQ(next.status(), SUCCESS) << key;
+		ASSERT_EQ(next.ans(), key - 1);
+		key = next.ans();
+	}
+	EXPECT_EQ(set.predecessor(0).status(), FAILURE);
+	for (key = 0; key <= maxKey; key += 2)
+	{
+		ASSERT_EQ(set.remove(key), SUCCESS) << key;
+	}
+	for (key = 1; key < maxKey; key += 2)
+	{
+		EXPECT_EQ(set.successor(key).ans(), key + 2) << key;
+		EXPECT_EQ(set.predecessor(key + 1).ans(), key) << key + 1;
+	}
+}
+
+#endif
@@ -0,0 +1,342 @@
+//
+// Shared tests for the ordered indexes over non-negative int ids that can replace AVL_Tree<int, V> as
+// olympics_t::teamsById: CompressedIdIndex<V> (COMPRESSED_ID_INDEX) and IntegerOrderedSet<V> (INTEGER_ORDERED_SET,
+// default constructed, so its universe is 0..INT_MAX). Each one runs when its feature is in DS2_FEATURES.
+// Interface as AVL_Tree (insert, remove, find, get_min, get_max, get_size, to_vec), plus predecessor(id) and
+// successor(id), which return the closest smaller / bigger id in the index. Negative ids are INVALID_INPUT.
+// Tests that only apply to one of the indexes are in its own file.
+//
+
+#if defined(DS2_TEST_COMPRESSED_ID_INDEX) || defined(DS2_TEST_INTEGER_ORDERED_SET)
+#include "../../wet2util.h"
+#include "../lib/googletest/include/gtest/gtest.h"
+#ifdef DS2_TEST_COMPRESSED_ID_INDEX
+#include "../../CompressedIdIndex.h"
+#endif
+#ifdef DS2_TEST_INTEGER_ORDERED_SET
+#include "../../IntegerOrderedSet.h"
+#endif
+#include "../../AVL_Tree.h"
+#include "../AllocationTracker.h"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#define SUCCESS StatusType::SUCCESS
+#define FAILURE StatusType::FAILURE
+
+// Lets a test instantiate the index under test with any value type
+template <template <class> class Index>
+struct IndexOf
+{
+	template <class V>
+	using type = Index<V>;
+};
+
+#if defined(DS2_TEST_COMPRESSED_ID_INDEX) && defined(DS2_TEST_INTEGER_ORDERED_SET)
+using OrderedIdIndexTypes = ::testing::Types<IndexOf<CompressedIdIndex>, IndexOf<IntegerOrderedSet>>;
+#elif defined(DS2_TEST_COMPRESSED_ID_INDEX)
+using OrderedIdIndexTypes = ::testing::Types<IndexOf<CompressedIdIndex>>;
+#else
+using OrderedIdIndexTypes = ::testing::Types<IndexOf<IntegerOrderedSet>>;
+#endif
+
+// Stands in for Team in the id -> team lookup tests
+struct TeamRecord
+{
+	int id;
+	int strength;
+};
+
+template <class T>
+class OrderedIdIndexTest : public ::testing::Test
+{
+protected:
+	using IntIndex = typename T::template type<int>;
+	using TeamIndex = typename T::template type<TeamRecord*>;
+
+	IntIndex index = IntIndex();
+
+	// Dense ids like the Olympics fixtures, ids on both sides of word, block and summary level boundaries, and the
+	// largest ids of the int range
+	std::vector<int> ids = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,
+							26, 27, 28, 29, 30, 62, 63, 64, 65, 127, 128, 4095, 4096, 4097, 65535, 65536, 65537, 262143,
+							262144, 262145, 16777215, 16777216, 1000000007, 1073741824, INT_MAX - 1, INT_MAX};
+
+	void SetUp() override
+	{
+		std::vector<int> shuffled = ids;
+		std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(2024));
+		for (int id : shuffled)
+		{
+			index.insert(id, id % 1000);
+		}
+	}
+};
+
+TYPED_TEST_SUITE(OrderedIdIndexTest, OrderedIdIndexTypes);
+
+TYPED_TEST(OrderedIdIndexTest, Constructor)
+{
+	typename TestFixture::IntIndex index = typename TestFixture::IntIndex();
+	EXPECT_EQ(index.get_size(), 0);
+	EXPECT_EQ(index.find(0).status(), FAILURE);
+	EXPECT_EQ(index.get_min().status(), FAILURE);
+	EXPECT_EQ(index.get_max().status(), FAILURE);
+	EXPECT_EQ(index.predecessor(10).status(), FAILURE);
+	EXPECT_EQ(index.successor(10).status(), FAILURE);
+	std::vector<Pair<int, int>> res = std::vector<Pair<int, int>>();
+	EXPECT_EQ(index.to_vec(), res);
+}
+
+TYPED_TEST(OrderedIdIndexTest, InsertFind)
+{
+	auto& index = this->index;
+	ASSERT_EQ(index.get_size(), this->ids.size());
+	for (int id : this->ids)
+	{
+		auto res = index.find(id);
+		EXPECT_EQ(res.status(), SUCCESS) << id;
+		EXPECT_EQ(res.ans(), id % 1000) << id;
+		EXPECT_EQ(index.insert(id, 0), FAILURE) << id;
+	}
+	for (int id : {31, 61, 66, 126, 129, 4094, 4098, 65534, 65538, 262142, 262146, 16777214, 16777217, 1000000006,
+				   1000000008, INT_MAX - 2})
+	{
+		EXPECT_EQ(index.find(id).status(), FAILURE) << id;
+	}
+	EXPECT_EQ(index.get_size(), this->ids.size());
+}
+
+TYPED_TEST(OrderedIdIndexTest, InvalidIds)
+{
+	auto& index = this->index;
+	EXPECT_EQ(index.insert(-1, 0), StatusType::INVALID_INPUT);
+	EXPECT_EQ(index.insert(INT_MIN, 0), StatusType::INVALID_INPUT);
+	EXPECT_EQ(index.remove(-1), StatusType::INVALID_INPUT);
+	EXPECT_EQ(index.find(-1).status(), StatusType::INVALID_INPUT);
+	EXPECT_EQ(index.get_size(), this->ids.size());
+}
+
+TYPED_TEST(OrderedIdIndexTest, MinMax)
+{
+	auto& index = this->index;
+	EXPECT_EQ(index.get_min().ans(), 0);
+	EXPECT_EQ(index.get_max().ans(), INT_MAX % 1000);
+	EXPECT_EQ(index.remove(0), SUCCESS);
+	EXPECT_EQ(index.remove(INT_MAX), SUCCESS);
+	EXPECT_EQ(index.get_min().ans(), 1);
+	EXPECT_EQ(index.get_max().ans(), (INT_MAX - 1) % 1000);
+}
+
+TYPED_TEST(OrderedIdIndexTest, PredecessorSuccessor)
+{
+	auto& index = this->index;
+	const std::vector<int>& ids = this->ids;
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		auto pred = index.predecessor(ids[i]);
+		auto succ = index.successor(ids[i]);
+		if (i == 0)
+		{
+			EXPECT_EQ(pred.status(), FAILURE);
+		}
+		else
+		{
+			EXPECT_EQ(pred.status(), SUCCESS) << ids[i];
+			EXPECT_EQ(pred.ans(), ids[i - 1]) << ids[i];
+		}
+		if (i == ids.size() - 1)
+		{
+			EXPECT_EQ(succ.status(), FAILURE);
+		}
+		else
+		{
+			EXPECT_EQ(succ.status(), SUCCESS) << ids[i];
+			EXPECT_EQ(succ.ans(), ids[i + 1]) << ids[i];
+		}
+	}
+	// Ids that are not in the index, with long empty stretches in between
+	EXPECT_EQ(index.predecessor(50).ans(), 30);
+	EXPECT_EQ(index.successor(50).ans(), 62);
+	EXPECT_EQ(index.predecessor(1000).ans(), 128);
+	EXPECT_EQ(index.successor(1000).ans(), 4095);
+	EXPECT_EQ(index.predecessor(100000).ans(), 65537);
+	EXPECT_EQ(index.successor(100000).ans(), 262143);
+	EXPECT_EQ(index.predecessor(1000000000).ans(), 16777216);
+	EXPECT_EQ(index.successor(1000000000).ans(), 1000000007);
+	EXPECT_EQ(index.successor(1073741825).ans(), INT_MAX - 1);
+}
+
+TYPED_TEST(OrderedIdIndexTest, RemoveAndOrder)
+{
+	auto& index = this->index;
+	const std::vector<int>& ids = this->ids;
+	for (size_t i = 0; i < ids.size(); i += 2)
+	{
+		EXPECT_EQ(index.remove(ids[i]), SUCCESS) << ids[i];
+		EXPECT_EQ(index.remove(ids[i]), FAILURE) << ids[i];
+	}
+	std::vector<Pair<int, int>> res;
+	for (size_t i = 1; i < ids.size(); i += 2)
+	{
+		res.emplace_back(ids[i], ids[i] % 1000);
+	}
+	EXPECT_EQ(index.to_vec(), res);
+	EXPECT_EQ(index.get_size(), res.size());
+	EXPECT_EQ(index.successor(ids[0]).ans(), ids[1]);
+}
+
+// The same random operations on an AVL_Tree and on the index must give the same results, with std::set as the
+// reference for predecessor and successor
+TYPED_TEST(OrderedIdIndexTest, RandomOperationsMatchAVLTree)
+{
+	typename TestFixture::IntIndex index = typename TestFixture::IntIndex();
+	AVL_Tree<int, int> tree = AVL_Tree<int, int>();
+	std::set<int> ids;
+	std::mt19937 gen(2024);
+	std::uniform_int_distribution<int> dense(0, 5000);
+	std::uniform_int_distribution<int> spread(0, INT_MAX);
+	std::uniform_int_distribution<int> kind(0, 9);
+	for (int i = 0; i < 50000; ++i)
+	{
+		int id = kind(gen) < 8 ? dense(gen) : spread(gen);
+		int k = kind(gen);
+		if (k < 4)
+		{
+			auto expected = tree.insert(id, i);
+			EXPECT_EQ(index.insert(id, i), expected) << id;
+			ids.insert(id);
+		}
+		else if (k < 7)
+		{
+			auto expected = tree.remove(id);
+			EXPECT_EQ(index.remove(id), expected) << id;
+			ids.erase(id);
+		}
+		else if (k < 8)
+		{
+			auto expected = tree.find(id);
+			auto res = index.find(id);
+			EXPECT_EQ(res.status(), expected.status()) << id;
+			if (expected.status() == SUCCESS)
+			{
+				EXPECT_EQ(res.ans(), expected.ans()) << id;
+			}
+		}
+		else
+		{
+			auto it = ids.upper_bound(id);
+			auto succ = index.successor(id);
+			EXPECT_EQ(succ.status(), it == ids.end() ? FAILURE : SUCCESS) << id;
+			if (it != ids.end())
+			{
+				EXPECT_EQ(succ.ans(), *it) << id;
+			}
+			it = ids.lower_bound(id);
+			auto pred = index.predecessor(id);
+			EXPECT_EQ(pred.status(), it == ids.begin() ? FAILURE : SUCCESS) << id;
+			if (it != ids.begin())
+			{
+				EXPECT_EQ(pred.ans(), *std::prev(it)) << id;
+			}
+		}
+		ASSERT_EQ(index.get_size(), tree.get_size());
+	}
+	EXPECT_EQ(index.get_min().ans(), tree.get_min().ans());
+	EXPECT_EQ(index.get_max().ans(), tree.get_max().ans());
+	EXPECT_TRUE(index.to_vec() == tree.to_vec());
+}
+
+// The index used as olympics_t::teamsById: team ids mapped to pointers to teams owned elsewhere, with teams added
+// and removed over time. Lookups must return the same team object, and predecessor / successor must lead to the
+// neighbouring teams
+TYPED_TEST(OrderedIdIndexTest, TeamLookup)
+{
+	typename TestFixture::TeamIndex teamsById = typename TestFixture::TeamIndex();
+	const int numTeams = 2000;
+	std::vector<TeamRecord> teams;
+	for (int i = 1; i <= numTeams; ++i)
+	{
+		teams.push_back({i * 37, i % 50});
+	}
+	for (TeamRecord& team : teams)
+	{
+		ASSERT_EQ(teamsById.insert(team.id, &team), SUCCESS) << team.id;
+	}
+
+	// Remove every third team, then add back every other removed one, as add_team / remove_team would
+	std::set<int> live;
+	for (const TeamRecord& team : teams)
+	{
+		live.insert(team.id);
+	}
+	for (int i = 0; i < numTeams; i += 3)
+	{
+		EXPECT_EQ(teamsById.remove(teams[i].id), SUCCESS) << teams[i].id;
+		live.erase(teams[i].id);
+	}
+	for (int i = 0; i < numTeams; i += 6)
+	{
+		EXPECT_EQ(teamsById.insert(teams[i].id, &teams[i]), SUCCESS) << teams[i].id;
+		live.insert(teams[i].id);
+	}
+	ASSERT_EQ(teamsById.get_size(), live.size());
+
+	for (TeamRecord& team : teams)
+	{
+		auto res = teamsById.find(team.id);
+		if (live.count(team.id) == 0)
+		{
+			EXPECT_EQ(res.status(), FAILURE) << team.id;
+			continue;
+		}
+		ASSERT_EQ(res.status(), SUCCESS) << team.id;
+		EXPECT_EQ(res.ans(), &team) << team.id;
+		EXPECT_EQ(res.ans()->id, team.id);
+
+		auto next = teamsById.successor(team.id);
+		auto it = live.upper_bound(team.id);
+		ASSERT_EQ(next.status(), it == live.end() ? FAILURE : SUCCESS) << team.id;
+		if (it != live.end())
+		{
+			EXPECT_EQ(next.ans(), *it) << team.id;
+			EXPECT_EQ(teamsById.find(next.ans()).ans()->id, *it) << team.id;
+		}
+	}
+
+	auto byId = teamsById.to_vec();
+	ASSERT_EQ(byId.size(), live.size());
+	auto it = live.begin();
+	for (const auto& pair : byId)
+	{
+		EXPECT_EQ(pair.get_first(), *it);
+		EXPECT_EQ(pair.get_second()->id, *it);
+		++it;
+	}
+	EXPECT_EQ(teamsById.get_min().ans()->id, *live.begin());
+	EXPECT_EQ(teamsById.get_max().ans()->id, *live.rbegin());
+}
+
+TYPED_TEST(OrderedIdIndexTest, NoLeaks)
+{
+	AllocationScope scope;
+	{
+		typename TestFixture::IntIndex index = typename TestFixture::IntIndex();
+		for (int id = 0; id < 100000; ++id)
+		{
+			index.insert(id * 977, id);
+		}
+		for (int id = 0; id < 100000; id += 2)
+		{
+			index.remove(id * 977);
+		}
+	}
+	EXPECT_EQ(scope.liveBytes(), 0);
+	EXPECT_EQ(scope.allocations(), scope.deallocations());
+}
+#endif
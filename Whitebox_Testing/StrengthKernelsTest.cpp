@@ -0,0 +1,148 @@
+//
+// Tests for the strength aggregation kernels in StrengthKernels.h, which Team runs over its contiguous array of
+// player strengths: strengths_sum, strengths_max, strengths_count_above and strengths_median (the lower median,
+// via nth_element on a scratch copy). select_kernels(isa) chooses the AVX2 or the scalar implementation and
+// returns the one actually in use (SCALAR when the CPU has no AVX2); the default is the best one available.
+// Both must give the same answers as a plain loop, for any length and alignment. Each test runs with every
+// implementation the machine supports.
+//
+
+#ifdef DS2_TEST_TEAM_SIMD_STRENGTH
+#include "../../wet2util.h"
+#include "../lib/googletest/include/gtest/gtest.h"
+#include "../../StrengthKernels.h"
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+
+#define SUITE StrengthKernelsTest
+
+// Lengths around the 8-int AVX2 lane count and its multiples, and a large team
+static const int LENGTHS[] = {0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 100000};
+
+static std::vector<int> randomStrengths(int n, int maxStrength, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> strength(1, maxStrength);
+	std::vector<int> strengths(n);
+	for (int& s : strengths)
+	{
+		s = strength(gen);
+	}
+	return strengths;
+}
+
+static int lowerMedian(std::vector<int> strengths)
+{
+	if (strengths.empty())
+	{
+		return 0;
+	}
+	std::sort(strengths.begin(), strengths.end());
+	return strengths[(strengths.size() - 1) / 2];
+}
+
+// The kernel implementations this machine supports
+static std::vector<KernelIsa> supportedIsas()
+{
+	std::vector<KernelIsa> isas = {KernelIsa::SCALAR};
+	if (select_kernels(KernelIsa::AVX2) == KernelIsa::AVX2)
+	{
+		isas.push_back(KernelIsa::AVX2);
+	}
+	return isas;
+}
+
+static const char* isaName(KernelIsa isa)
+{
+	return isa == KernelIsa::AVX2 ? "AVX2" : "scalar";
+}
+
+// Checks every kernel on strengths[offset..offset + n), so the start is not always aligned
+static void expectMatchesLoop(const std::vector<int>& strengths, int offset, int n, KernelIsa isa)
+{
+	const int* begin = strengths.data() + offset;
+	std::vector<int> slice(begin, begin + n);
+	long long sum = 0;
+	int max = 0;
+	for (int s : slice)
+	{
+		sum += s;
+		max = std::max(max, s);
+	}
+	int threshold = lowerMedian(slice);
+	int above = static_cast<int>(std::count_if(slice.begin(), slice.end(), [threshold](int s)
+	{
+		return s > threshold;
+	}));
+	
+	std::vector<int> scratch(n + 1);
+	EXPECT_EQ(strengths_sum(begin, n), sum) << isaName(isa) << ", n = " << n << ", offset " << offset;
+	EXPECT_EQ(strengths_max(begin, n), max) << isaName(isa) << ", n = " << n << ", offset " << offset;
+	EXPECT_EQ(strengths_count_above(begin, n, threshold), above)
+						<< isaName(isa) << ", n = " << n << ", offset " << offset;
+	EXPECT_EQ(strengths_median(begin, n, scratch.data()), threshold)
+						<< isaName(isa) << ", n = " << n << ", offset " << offset;
+	EXPECT_TRUE(std::equal(slice.begin(), slice.end(), begin)) << isaName(isa) << " kernels modified their input";
+}
+
+TEST(SUITE, MatchLoopForAllLengths)
+{
+	for (KernelIsa isa : supportedIsas())
+	{
+		select_kernels(isa);
+		for (int n : LENGTHS)
+		{
+			std::vector<int> strengths = randomStrengths(n + 3, 1000, n);
+			for (int offset : {0, 1, 3})
+			{
+				expectMatchesLoop(strengths, offset, n, isa);
+			}
+		}
+	}
+	select_kernels(KernelIsa::AVX2);
+}
+
+// Sums of many large strengths overflow an int, and a maximum in the last lane or the tail must be found
+TEST(SUITE, LargeValuesAndTail)
+{
+	for (KernelIsa isa : supportedIsas())
+	{
+		select_kernels(isa);
+		for (int n : LENGTHS)
+		{
+			std::vector<int> strengths(n, INT_MAX - 1);
+			if (n > 0)
+			{
+				strengths[n - 1] = INT_MAX;
+				EXPECT_EQ(strengths_sum(strengths.data(), n), static_cast<long long>(INT_MAX - 1) * n + 1)
+									<< isaName(isa) << ", n = " << n;
+			}
+			expectMatchesLoop(strengths, 0, n, isa);
+		}
+	}
+	select_kernels(KernelIsa::AVX2);
+}
+
+// Many equal strengths, as in teams built from few distinct player strengths
+TEST(SUITE, ManyTies)
+{
+	for (KernelIsa isa : supportedIsas())
+	{
+		select_kernels(isa);
+		for (int n : LENGTHS)
+		{
+			expectMatchesLoop(randomStrengths(n, 3, n + 1), 0, n, isa);
+		}
+	}
+	select_kernels(KernelIsa::AVX2);
+}
+
+TEST(SUITE, ScalarAlwaysAvailable)
+{
+	EXPECT_TRUE(select_kernels(KernelIsa::SCALAR) == KernelIsa::SCALAR);
+	select_kernels(KernelIsa::AVX2);
+}
+#endif
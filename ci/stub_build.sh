@@ -0,0 +1,35 @@
+#!/bin/sh
+#
+# Compiles every test, benchmark and fuzz target with every optional feature enabled (DS2_FEATURES=ALL), against
+# the interface stubs in ci/stub_parent instead of a real parent project. Nothing is linked or run: this only
+# catches feature-guarded code that no longer compiles, or that uses a member the README does not list.
+#
+# Usage: ci/stub_build.sh [workDir]
+# googletest is taken from $GTEST_DIR, else from this repo's lib directory, else cloned from GitHub at $GTEST_TAG
+# (a pinned release by default).
+#
+
+set -eu
+
+repo=$(cd "$(dirname "$0")/.." && pwd)
+work=${1:-"$repo/_stub_build"}
+GTEST_TAG=${GTEST_TAG:-v1.14.0}
+
+rm -rf "$work"
+mkdir -p "$work"
+cp -R "$repo/ci/stub_parent/." "$work/"
+
+# A copy rather than a symlink, so that the tests' "../../" includes resolve to the stubs
+mkdir "$work/DS2_Tests"
+(cd "$repo" && git ls-files -co --exclude-standard -- . ':!lib' | tar -cf - -T -) | tar -xf - -C "$work/DS2_Tests"
+
+if [ -n "${GTEST_DIR:-}" ]; then
+	ln -s "$GTEST_DIR" "$work/DS2_Tests/lib"
+elif [ -f "$repo/lib/CMakeLists.txt" ]; then
+	ln -s "$repo/lib" "$work/DS2_Tests/lib"
+else
+	git clone --quiet --depth 1 --branch "$GTEST_TAG" https://github.com/google/googletest.git "$work/DS2_Tests/lib"
+fi
+
+cmake -S "$work" -B "$work/build" -DDS2_FEATURES=ALL -DDS2_BENCHMARKS=ON -DDS2_FUZZING=ON
+cmake --build "$work/build" -j "$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 2)"
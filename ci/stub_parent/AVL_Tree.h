@@ -0,0 +1,68 @@
+//
+// Interface stub of the parent project's AVL_Tree: every member the tests and benchmarks call, including those of
+// the optional features. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_AVL_TREE_H
+#define DATASTRUCTURES2_STUB_AVL_TREE_H
+
+#include <ostream>
+#include <vector>
+#include "wet2util.h"
+#include "Pair.h"
+
+template<class K, class V>
+class AVL_Tree
+{
+public:
+	AVL_Tree();
+	AVL_Tree(V* values, K* keys, int n);
+	AVL_Tree(const AVL_Tree& other);
+	~AVL_Tree();
+
+	StatusType insert(const K& key, const V& value);
+	StatusType remove(const K& key);
+	output_t<V> find(const K& key) const;
+	output_t<V> get_min() const;
+	output_t<V> get_max() const;
+	int get_size() const;
+	bool is_valid() const;
+	std::vector<Pair<K, V>> to_vec() const;
+	void inorder(std::ostream& os) const;
+	StatusType add_extra(const K& key, int extra);
+	output_t<int> get_path_extra(const K& key) const;
+
+	// AVL_SNAPSHOT
+	class Snapshot
+	{
+	public:
+		output_t<V> find(const K& key) const;
+		int get_size() const;
+		bool is_valid() const;
+		std::vector<Pair<K, V>> to_vec() const;
+		void inorder(std::ostream& os) const;
+		output_t<int> get_path_extra(const K& key) const;
+	};
+	Snapshot snapshot() const;
+
+	// AVL_SPLIT_JOIN
+	StatusType split(const K& key, AVL_Tree& left, AVL_Tree& right);
+	StatusType join(AVL_Tree& left, const K& key, const V& value, AVL_Tree& right);
+
+	// AVL_EXPORT
+	StatusType export_columns(const char* path, bool delta) const;
+	StatusType import_columns(const char* path);
+
+	// MEMORY_POLICY
+	StatusType set_memory_policy(bool hugePages, int numaNode);
+
+	// AVL_BULK_BUILD
+	StatusType bulk_build(const V* values, const K* keys, int n, int threads);
+
+	// AVL_RELAXED_BALANCE
+	void set_relaxed_balance(bool relaxed);
+	void flush();
+	int get_pending_rebalances() const;
+};
+
+#endif //DATASTRUCTURES2_STUB_AVL_TREE_H
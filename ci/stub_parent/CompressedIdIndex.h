@@ -0,0 +1,30 @@
+//
+// Interface stub of COMPRESSED_ID_INDEX's CompressedIdIndex. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_COMPRESSEDIDINDEX_H
+#define DATASTRUCTURES2_STUB_COMPRESSEDIDINDEX_H
+
+#include <vector>
+#include "wet2util.h"
+#include "Pair.h"
+
+template<class V>
+class CompressedIdIndex
+{
+public:
+	CompressedIdIndex();
+	~CompressedIdIndex();
+
+	StatusType insert(int id, const V& value);
+	StatusType remove(int id);
+	output_t<V> find(int id) const;
+	output_t<V> get_min() const;
+	output_t<V> get_max() const;
+	output_t<int> predecessor(int id) const;
+	output_t<int> successor(int id) const;
+	int get_size() const;
+	std::vector<Pair<int, V>> to_vec() const;
+};
+
+#endif //DATASTRUCTURES2_STUB_COMPRESSEDIDINDEX_H
@@ -0,0 +1,24 @@
+//
+// Interface stub of CUCKOO_HASH's CuckooHashTable. Only the core HashTable interface, since the tests must not
+// need more of it. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_CUCKOOHASHTABLE_H
+#define DATASTRUCTURES2_STUB_CUCKOOHASHTABLE_H
+
+#include "wet2util.h"
+
+template<class K, class V>
+class CuckooHashTable
+{
+public:
+	CuckooHashTable();
+	~CuckooHashTable();
+
+	StatusType insert(const K& key, const V& value);
+	StatusType remove(const K& key);
+	output_t<V> find(const K& key) const;
+	int get_size() const;
+};
+
+#endif //DATASTRUCTURES2_STUB_CUCKOOHASHTABLE_H
@@ -0,0 +1,36 @@
+//
+// Interface stub of the parent project's HashTable, including the members of the optional features.
+// Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_HASHTABLE_H
+#define DATASTRUCTURES2_STUB_HASHTABLE_H
+
+#include "wet2util.h"
+
+template<class K, class V>
+class HashTable
+{
+public:
+	HashTable();
+	~HashTable();
+
+	StatusType insert(const K& key, const V& value);
+	StatusType remove(const K& key);
+	output_t<V> find(const K& key) const;
+	int get_size() const;
+
+	// HASH_FIND_MANY
+	void find_many(const K* keys, int n, output_t<V>* out) const;
+	void contains_many(const K* keys, int n, bool* out) const;
+
+	// MEMORY_POLICY
+	StatusType set_memory_policy(bool hugePages, int numaNode);
+
+	// HASH_MISS_FILTER
+	StatusType set_miss_filter(double falsePositiveRate);
+	long long get_filter_rejections() const;
+	long long get_filter_bytes() const;
+};
+
+#endif //DATASTRUCTURES2_STUB_HASHTABLE_H
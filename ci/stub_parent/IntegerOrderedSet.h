@@ -0,0 +1,31 @@
+//
+// Interface stub of INTEGER_ORDERED_SET's IntegerOrderedSet. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_INTEGERORDEREDSET_H
+#define DATASTRUCTURES2_STUB_INTEGERORDEREDSET_H
+
+#include <climits>
+#include <vector>
+#include "wet2util.h"
+#include "Pair.h"
+
+template<class V>
+class IntegerOrderedSet
+{
+public:
+	explicit IntegerOrderedSet(int maxKey = INT_MAX);
+	~IntegerOrderedSet();
+
+	StatusType insert(int key, const V& value);
+	StatusType remove(int key);
+	output_t<V> find(int key) const;
+	output_t<V> get_min() const;
+	output_t<V> get_max() const;
+	output_t<int> predecessor(int key) const;
+	output_t<int> successor(int key) const;
+	int get_size() const;
+	std::vector<Pair<int, V>> to_vec() const;
+};
+
+#endif //DATASTRUCTURES2_STUB_INTEGERORDEREDSET_H
@@ -0,0 +1,23 @@
+//
+// Interface stub of the parent project's Pair, as used by the tests. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_PAIR_H
+#define DATASTRUCTURES2_STUB_PAIR_H
+
+template<class T, class S>
+class Pair
+{
+public:
+	Pair(const T& first = T(), const S& second = S());
+
+	const T& get_first() const;
+	const S& get_second() const;
+
+	bool operator==(const Pair& other) const;
+	bool operator!=(const Pair& other) const;
+	bool operator<(const Pair& other) const;
+	bool operator>(const Pair& other) const;
+};
+
+#endif //DATASTRUCTURES2_STUB_PAIR_H
@@ -0,0 +1,5 @@
+//
+// Source file the test targets list for the parent's Player. The stub only declares it (see ci/stub_build.sh).
+//
+
+#include "Player.h"
@@ -0,0 +1,10 @@
+//
+// Interface stub of the parent project's Player. The tests never use it directly, so it is only declared.
+//
+
+#ifndef DATASTRUCTURES2_STUB_PLAYER_H
+#define DATASTRUCTURES2_STUB_PLAYER_H
+
+class Player;
+
+#endif //DATASTRUCTURES2_STUB_PLAYER_H
@@ -0,0 +1,21 @@
+//
+// Interface stub of TEAM_SIMD_STRENGTH's StrengthKernels.h. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_STRENGTHKERNELS_H
+#define DATASTRUCTURES2_STUB_STRENGTHKERNELS_H
+
+enum class KernelIsa
+{
+	SCALAR,
+	AVX2
+};
+
+KernelIsa select_kernels(KernelIsa isa);
+
+long long strengths_sum(const int* strengths, int n);
+int strengths_max(const int* strengths, int n);
+int strengths_count_above(const int* strengths, int n, int threshold);
+int strengths_median(const int* strengths, int n, int* scratch);
+
+#endif //DATASTRUCTURES2_STUB_STRENGTHKERNELS_H
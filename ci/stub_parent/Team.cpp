@@ -0,0 +1,5 @@
+//
+// Source file the test targets list for the parent's Team. The stub only declares it (see ci/stub_build.sh).
+//
+
+#include "Team.h"
@@ -0,0 +1,12 @@
+//
+// Interface stub of the parent project's Team. The tests only hold Team pointers, so it is only declared.
+//
+
+#ifndef DATASTRUCTURES2_STUB_TEAM_H
+#define DATASTRUCTURES2_STUB_TEAM_H
+
+#include "Player.h"
+
+class Team;
+
+#endif //DATASTRUCTURES2_STUB_TEAM_H
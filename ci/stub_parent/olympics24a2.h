@@ -0,0 +1,72 @@
+//
+// Interface stub of the parent project's olympics_t: the public API, the three structures the white-box checks
+// read, and the members of the optional features. Declarations only (see ci/stub_build.sh).
+//
+
+#ifndef DATASTRUCTURES2_STUB_OLYMPICS24A2_H
+#define DATASTRUCTURES2_STUB_OLYMPICS24A2_H
+
+#include <vector>
+#include "wet2util.h"
+#include "HashTable.h"
+#include "AVL_Tree.h"
+#include "Pair.h"
+#include "Team.h"
+
+// OLYMPICS_CHANGE_FEED
+enum class ChangeType
+{
+	ADD_TEAM,
+	REMOVE_TEAM,
+	ADD_PLAYER,
+	REMOVE_PLAYER,
+	PLAY_MATCH
+};
+
+struct ChangeRecord
+{
+	ChangeType type;
+	int teamId;
+	int otherTeamId;
+	int oldStrength;
+	int newStrength;
+};
+
+class olympics_t
+{
+public:
+	HashTable<int, Team*> teamsHashTable;
+	AVL_Tree<int, Team*> teamsById;
+	AVL_Tree<Pair<int, int>, Team*> teamsByStrength;
+
+	olympics_t();
+	virtual ~olympics_t();
+
+	StatusType add_team(int teamId);
+	StatusType remove_team(int teamId);
+	StatusType add_player(int teamId, int playerStrength);
+	StatusType remove_newest_player(int teamId);
+	output_t<int> play_match(int teamId1, int teamId2);
+	output_t<int> num_wins_for_team(int teamId);
+	output_t<int> get_highest_ranked_team();
+	StatusType unite_teams(int teamId1, int teamId2);
+	output_t<int> play_tournament(int lowPower, int highPower);
+
+	// OLYMPICS_QUERY_CACHE
+	void enable_query_cache(int capacity);
+	int get_cache_hits() const;
+	int get_cache_misses() const;
+
+	// OLYMPICS_TOP_K
+	const std::vector<int>& top_k(int k);
+
+	// OLYMPICS_CHANGE_FEED
+	StatusType enable_change_feed(int capacity);
+	int drain_changes(ChangeRecord* out, int maxRecords);
+	long long get_dropped_changes() const;
+
+	// TEAM_SIMD_STRENGTH
+	void play_matches(const int* teamIds1, const int* teamIds2, int n, output_t<int>* out);
+};
+
+#endif //DATASTRUCTURES2_STUB_OLYMPICS24A2_H
@@ -0,0 +1,46 @@
+//
+// Stand-in for the course's wet2util.h, with the same StatusType, output_t and includes.
+//
+
+#ifndef DATASTRUCTURES2_STUB_WET2UTIL_H
+#define DATASTRUCTURES2_STUB_WET2UTIL_H
+
+#include <stdexcept>
+
+enum struct StatusType
+{
+	SUCCESS = 0,
+	ALLOCATION_ERROR = 1,
+	INVALID_INPUT = 2,
+	FAILURE = 3
+};
+
+template<typename T>
+class output_t
+{
+private:
+	const StatusType __status;
+	const T __ans;
+
+public:
+	output_t() : __status(StatusType::SUCCESS), __ans(T())
+	{}
+
+	output_t(StatusType status) : __status(status), __ans(T())
+	{}
+
+	output_t(const T& ans) : __status(StatusType::SUCCESS), __ans(ans)
+	{}
+
+	StatusType status()
+	{
+		return __status;
+	}
+
+	T ans()
+	{
+		return __ans;
+	}
+};
+
+#endif //DATASTRUCTURES2_STUB_WET2UTIL_H